@@ -0,0 +1,33 @@
+#ifndef WLED_HOST_TEST_H
+#define WLED_HOST_TEST_H
+/*
+ * Minimal check macros for the host tests in this directory (see Makefile).
+ * A failed CHECK prints its location and the test exits non-zero at the end of main().
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+static int hostTestFailures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); hostTestFailures++; } \
+  } while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long _a = (long long)(a), _b = (long long)(b); \
+    if (_a != _b) { printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); hostTestFailures++; } \
+  } while (0)
+
+// call at the end of main()
+static inline int hostTestResult(const char *name) {
+  printf("%s: %s\n", name, hostTestFailures ? "FAILED" : "passed");
+  return hostTestFailures ? 1 : 0;
+}
+
+// wall clock in microseconds, for throughput figures
+static inline uint64_t hostMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * JitterBuffer: synthetic arrival time traces fed to commit(), present() polled every millisecond
+ * as the main loop would. Each frame carries its number in pixel 0.
+ */
+#include <string.h>
+#include <vector>
+#include "host_test.h"
+#include "jitter_buffer.h"
+
+struct Shown {
+  uint32_t time;
+  uint32_t pixel;
+  bool     blend; // 50% blend after a late frame
+};
+
+// arrivals: times (ms) at which frames 0, 1, 2, ... are complete
+static std::vector<Shown> run(JitterBuffer &jb, const std::vector<uint32_t> &arrivals, uint32_t start, uint32_t duration,
+                              uint16_t latency = 50, bool interpolate = true) {
+  std::vector<Shown> shown;
+  size_t next = 0;
+  for (uint32_t t = start; t != start + duration; t++) {
+    while (next < arrivals.size() && arrivals[next] == t) {
+      for (uint16_t i = 0; i < jb.getLength(); i++) jb.getWriteFrame()[i] = next;
+      jb.commit(t);
+      next++;
+    }
+    JitterBuffer::Stats s;
+    jb.getStats(s);
+    const uint32_t blends = s.interpolated;
+    const uint32_t *f = jb.present(t, latency, interpolate);
+    jb.getStats(s);
+    if (f) shown.push_back({t, f[0], s.interpolated != blends});
+  }
+  return shown;
+}
+
+// 30 fps stream that arrives in pairs every 66 ms (Wi-Fi aggregation)
+static void testBurstyArrival(uint32_t start) {
+  JitterBuffer jb;
+  CHECK(jb.allocate(4, 16));
+  std::vector<uint32_t> arrivals;
+  for (int k = 0; k < 300; k++) arrivals.push_back(start + 100 + (k / 2) * 66);
+  std::vector<Shown> shown = run(jb, arrivals, start, 10500);
+
+  JitterBuffer::Stats s;
+  jb.getStats(s);
+  CHECK_EQ(s.received, 300);
+  CHECK_EQ(s.dropped, 0);
+  CHECK_EQ(s.presented, 300);
+  CHECK_EQ(shown.size(), 300);
+  for (size_t i = 0; i < shown.size(); i++) CHECK_EQ(shown[i].pixel, i); // in order, none repeated
+
+  // once the cadence is established (2 s) frames are shown every 33 ms instead of 0/66 ms
+  uint32_t minGap = UINT32_MAX, maxGap = 0;
+  for (size_t i = 1; i < shown.size(); i++) {
+    if (shown[i].time - start < 2000) continue;
+    uint32_t gap = shown[i].time - shown[i-1].time;
+    if (gap < minGap) minGap = gap;
+    if (gap > maxGap) maxGap = gap;
+  }
+  printf("  bursty 30 fps: gaps %u..%u ms, interval %u, jitter %u, latency %u\n", minGap, maxGap, s.interval, s.jitter, s.latency);
+  CHECK(minGap >= 28);
+  CHECK(maxGap <= 38);
+  CHECK(s.interval >= 32 && s.interval <= 34);
+  CHECK(s.latency <= 100);
+}
+
+// a frame missing its due time holds the last frame, then eases in with a 50% blend
+static void testLateFrame() {
+  JitterBuffer jb;
+  CHECK(jb.allocate(2, 4));
+  std::vector<uint32_t> arrivals;
+  for (int k = 0; k < 40; k++) arrivals.push_back(100 + k * 40);
+  for (int k = 40; k < 60; k++) arrivals.push_back(100 + k * 40 + 150); // 150 ms gap before frame 40
+  const uint32_t end = arrivals.back() + 100; // last frame shown, before the end of the stream counts as late
+  std::vector<Shown> shown = run(jb, arrivals, 0, end);
+
+  JitterBuffer::Stats s;
+  jb.getStats(s);
+  CHECK_EQ(s.late, 1);
+  CHECK_EQ(s.interpolated, 1);
+  CHECK_EQ(s.presented, 60);
+  CHECK_EQ(shown.size(), 61); // and one blend
+  bool blended = false;
+  for (size_t i = 1; i < shown.size(); i++) {
+    if (shown[i].blend) {
+      CHECK_EQ(shown[i].pixel, (39 >> 1) + (40 >> 1)); // 50% of frames 39 and 40
+      CHECK_EQ(shown[i-1].pixel, 39);
+      CHECK(i + 1 < shown.size() && shown[i+1].pixel == 40);
+      blended = true;
+    }
+  }
+  CHECK(blended);
+
+  // without interpolation the late frame is shown directly
+  JitterBuffer plain;
+  CHECK(plain.allocate(2, 4));
+  shown = run(plain, arrivals, 0, end, 50, false);
+  plain.getStats(s);
+  CHECK_EQ(s.late, 1);
+  CHECK_EQ(s.interpolated, 0);
+  CHECK_EQ(shown.size(), 60);
+}
+
+// frames arriving faster than they can be presented push out the oldest ones
+static void testOverflow() {
+  JitterBuffer jb;
+  CHECK(jb.allocate(4, 4));
+  for (uint32_t k = 0; k < 10; k++) {
+    jb.getWriteFrame()[0] = k;
+    jb.commit(1000);
+  }
+  JitterBuffer::Stats s;
+  jb.getStats(s);
+  CHECK_EQ(s.received, 10);
+  CHECK_EQ(s.dropped, 6);
+  CHECK_EQ(s.depth, 4);
+  const uint32_t *f = jb.present(1000, 50, true); // full buffer starts presenting right away
+  CHECK(f && f[0] == 6);
+}
+
+static void testAllocation() {
+  JitterBuffer jb;
+  CHECK(!jb.isActive());
+  CHECK(!jb.allocate(4, 0));
+  CHECK(!jb.isActive());
+  CHECK(jb.allocate(20, 8)); // frames are limited to 8
+  CHECK_EQ(jb.getFrames(), 8);
+  CHECK(jb.present(0, 50, true) == nullptr); // nothing queued
+  jb.release();
+  CHECK(!jb.isActive());
+  CHECK(jb.present(0, 50, true) == nullptr);
+}
+
+int main() {
+  testAllocation();
+  testBurstyArrival(0);
+  testBurstyArrival(UINT32_MAX - 5000); // millis() wrapping during the stream
+  testLateFrame();
+  testOverflow();
+  return hostTestResult("jitter_buffer");
+}
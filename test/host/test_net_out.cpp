@@ -0,0 +1,362 @@
+/*
+ * NetOut: frames are encoded into packets captured by a stand-in send callback, then checked
+ * against the receive side (e131PacketProtocol() and the e131_packet_t layout used by e131.cpp)
+ * and, for DDP and Art-Net, byte by byte against the former per-field write implementation.
+ * Prints throughput for a 4000 pixel network bus.
+ */
+#include <string.h>
+#include <vector>
+#include "host_test.h"
+#include "net_out.h"
+#include "src/dependencies/e131/E131Packet.h"
+
+struct Packet {
+  uint16_t port;
+  std::vector<uint8_t> data;
+};
+
+static bool capture(uint16_t port, const uint8_t *packet, size_t size, void *arg) {
+  ((std::vector<Packet>*)arg)->push_back({port, std::vector<uint8_t>(packet, packet + size)});
+  return true;
+}
+
+static uint16_t get16(const uint8_t *p) { return (p[0] << 8) | p[1]; }
+
+static uint8_t scale8(uint8_t i, uint8_t scale) { return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8; } // as FastLED
+
+/*
+ * Reference: realtimeBroadcast() DDP and Art-Net output before packets were assembled in a buffer,
+ * writing every header field and every scaled channel through its own UDP write() call.
+ * UdpStub stands in for WiFiUDP (virtual Print::write(), bytes appended to the packet being built).
+ */
+class UdpStub {
+  public:
+    virtual ~UdpStub() {}
+    void beginPacket(uint16_t port) { _port = port; _data.clear(); }
+    // not inlined: every write is a call into the UDP stack on the device
+    __attribute__((noinline)) virtual size_t write(uint8_t b) { _data.push_back(b); return 1; }
+    __attribute__((noinline)) virtual size_t write(const uint8_t *b, size_t n) { _data.insert(_data.end(), b, b + n); return n; }
+    void endPacket() { if (_out) _out->push_back({_port, _data}); _packets++; }
+    std::vector<Packet> *_out = nullptr; // captured packets, nullptr when benchmarking
+    std::vector<uint8_t> _data;
+    uint16_t _port = 0;
+    size_t   _packets = 0;
+};
+
+static size_t legacySequence = 0; // shared by DDP and Art-Net as in udp.cpp
+
+static void legacyBroadcast(UdpStub &udp, uint8_t type, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW) {
+  static const uint8_t ART_NET_HEADER[] = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+  const size_t channelCount = length * (isRGBW ? 4 : 3);
+  size_t bufferOffset = 0;
+  if (type == NETOUT_DDP) {
+    const size_t packetCount = ((channelCount-1) / 1440) + 1;
+    uint32_t channel = 0;
+    for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+      if (legacySequence > 15) legacySequence = 0;
+      udp.beginPacket(DDP_DEFAULT_PORT);
+      size_t packetSize = 1440;
+      uint8_t flags = 0x40;
+      if (currentPacket == packetCount - 1U) {
+        flags = 0x40 | 0x01;
+        if (channelCount % 1440) packetSize = channelCount % 1440;
+      }
+      udp.write(flags);
+      udp.write(legacySequence++ & 0x0F);
+      udp.write(isRGBW ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
+      udp.write(1);
+      udp.write(0xFF & (channel >> 24));
+      udp.write(0xFF & (channel >> 16));
+      udp.write(0xFF & (channel >>  8));
+      udp.write(0xFF & (channel      ));
+      udp.write(0xFF & (packetSize >> 8));
+      udp.write(0xFF & (packetSize     ));
+      for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
+        udp.write(scale8(buffer[bufferOffset++], bri));
+        udp.write(scale8(buffer[bufferOffset++], bri));
+        udp.write(scale8(buffer[bufferOffset++], bri));
+        if (isRGBW) udp.write(scale8(buffer[bufferOffset++], bri));
+      }
+      udp.endPacket();
+      channel += packetSize;
+    }
+  } else if (type == NETOUT_ARTNET) {
+    const size_t perPacket = isRGBW ? 512 : 510;
+    const size_t packetCount = ((channelCount-1) / perPacket) + 1;
+    legacySequence++;
+    for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+      if (legacySequence > 255) legacySequence = 0;
+      udp.beginPacket(ARTNET_DEFAULT_PORT);
+      size_t packetSize = perPacket;
+      if (currentPacket == packetCount - 1U && (channelCount % perPacket)) packetSize = channelCount % perPacket;
+      udp.write(ART_NET_HEADER, sizeof(ART_NET_HEADER));
+      udp.write(legacySequence & 0xFF);
+      udp.write(0x00);
+      udp.write(currentPacket & 0xFF);
+      udp.write(0x00);
+      udp.write(0xFF & (packetSize >> 8));
+      udp.write(0xFF & (packetSize     ));
+      for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
+        udp.write(scale8(buffer[bufferOffset++], bri));
+        udp.write(scale8(buffer[bufferOffset++], bri));
+        udp.write(scale8(buffer[bufferOffset++], bri));
+        if (isRGBW) udp.write(scale8(buffer[bufferOffset++], bri));
+      }
+      udp.endPacket();
+    }
+  }
+}
+
+// send callback writing into the UDP stand-in with a single write per packet, as udp.cpp does
+static bool sendStub(uint16_t port, const uint8_t *packet, size_t size, void *arg) {
+  UdpStub *udp = (UdpStub*)arg;
+  udp->beginPacket(port);
+  udp->write(packet, size);
+  udp->endPacket();
+  return true;
+}
+
+static const uint8_t mac[6] = { 0x24, 0x0A, 0xC4, 0x12, 0x34, 0x56 };
+
+static NetOutParams params(uint8_t type, bool rgbw, const uint8_t *lut = nullptr) {
+  NetOutParams p;
+  p.type     = type;
+  p.rgbw     = rgbw;
+  p.syncOut  = false;
+  p.priority = 0;
+  p.source   = "WLED test";
+  p.mac      = mac;
+  p.lut      = lut;
+  return p;
+}
+
+static void pattern(std::vector<uint8_t> &buf, size_t channels, uint8_t seed) {
+  buf.resize(channels);
+  for (size_t i = 0; i < channels; i++) buf[i] = (uint8_t)(i * 7 + seed);
+}
+
+// decodes E1.31 packets the way a receiver does, returns the channels of all universes in order
+static std::vector<uint8_t> e131Decode(const std::vector<Packet> &packets, const NetOutParams &par, uint8_t &seq) {
+  std::vector<uint8_t> channels;
+  const size_t perUniverse = par.rgbw ? 512 : 510;
+  for (size_t i = 0; i < packets.size(); i++) {
+    const std::vector<uint8_t> &d = packets[i].data;
+    CHECK_EQ(packets[i].port, E131_DEFAULT_PORT);
+    CHECK_EQ(e131PacketProtocol(d.data(), d.size(), E131_DEFAULT_PORT), P_E131);
+    const e131_packet_t *p = (const e131_packet_t*)d.data();
+    const uint8_t *raw = d.data();
+
+    // root layer
+    CHECK_EQ(get16(raw + E131_ROOT_PREAMBLE_SIZE), 0x0010);
+    CHECK_EQ(get16(raw + E131_ROOT_POSTAMBLE_SIZE), 0);
+    CHECK(memcmp(p->acn_id, E131_ACN_ID, sizeof(p->acn_id)) == 0);
+    CHECK_EQ(get16(raw + E131_ROOT_FLENGTH), 0x7000 | (d.size() - E131_ROOT_FLENGTH));
+    CHECK(memcmp(p->cid, "WLED-sACN-", 10) == 0 && memcmp(p->cid + 10, mac, 6) == 0);
+    // framing layer
+    CHECK_EQ(get16(raw + E131_FRAME_FLENGTH), 0x7000 | (d.size() - E131_FRAME_FLENGTH));
+    CHECK(strcmp((const char*)p->source_name, par.source) == 0);
+    CHECK_EQ(p->priority, par.priority ? par.priority : 100);
+    CHECK_EQ(get16(raw + E131_FRAME_RESERVED), par.syncOut ? NETOUT_E131_SYNC_UNIVERSE : 0);
+    CHECK_EQ(p->options, 0);
+    CHECK_EQ(get16(raw + E131_FRAME_UNIVERSE), i + 1); // universes start at 1
+    if (i == 0) seq = p->sequence_number;
+    CHECK_EQ(p->sequence_number, seq);                   // one sequence number per frame
+    // DMP layer
+    CHECK_EQ(get16(raw + E131_DMP_FLENGTH), 0x7000 | (d.size() - E131_DMP_FLENGTH));
+    CHECK_EQ(p->type, 0xA1);
+    CHECK_EQ(get16(raw + E131_DMP_ADDR_FIRST), 0);
+    CHECK_EQ(get16(raw + E131_DMP_ADDR_INC), 1);
+    const uint16_t count = get16(raw + E131_DMP_COUNT);
+    CHECK_EQ(d.size(), E131_DMP_DATA + count);
+    CHECK(count - 1 <= (int)perUniverse);
+    CHECK(i + 1 == packets.size() || count - 1 == (int)perUniverse); // only the last universe is partial
+    channels.insert(channels.end(), p->property_values + 1, p->property_values + count);
+  }
+  return channels;
+}
+
+static void testE131(bool rgbw, uint16_t pixels, const uint8_t *lut) {
+  NetOut out;
+  NetOutParams par = params(NETOUT_E131, rgbw, lut);
+  par.priority = lut ? 150 : 0;
+  const size_t cpp = rgbw ? 4 : 3;
+  std::vector<uint8_t> frame, expected;
+  uint8_t lastSeq = 0;
+  for (int f = 0; f < 3; f++) {
+    pattern(frame, pixels * cpp, f);
+    std::vector<Packet> packets;
+    CHECK(out.frame(par, frame.data(), pixels, capture, &packets));
+    CHECK_EQ(packets.size(), (pixels + (rgbw ? 127 : 169)) / (rgbw ? 128 : 170)); // whole pixels per universe
+    uint8_t seq;
+    std::vector<uint8_t> decoded = e131Decode(packets, par, seq);
+    expected = frame;
+    if (lut) for (uint8_t &c : expected) c = lut[c];
+    CHECK(decoded == expected);
+    if (f) CHECK_EQ((uint8_t)(seq - lastSeq), 1);
+    lastSeq = seq;
+  }
+
+  // sync output: sync address announced in data, synchronization packet for the same sequence number
+  par.syncOut = true;
+  std::vector<Packet> packets;
+  CHECK(out.frame(par, frame.data(), pixels, capture, &packets));
+  uint8_t seq;
+  e131Decode(packets, par, seq);
+  packets.clear();
+  CHECK(out.sync(par, capture, &packets));
+  CHECK_EQ(packets.size(), 1);
+  const std::vector<uint8_t> &s = packets[0].data;
+  CHECK_EQ(s.size(), E131_SYNC_PACKET_SIZE);
+  CHECK_EQ(e131PacketProtocol(s.data(), s.size(), E131_DEFAULT_PORT), P_E131);
+  CHECK(memcmp(s.data() + E131_ROOT_CID, "WLED-sACN-", 10) == 0);
+  CHECK_EQ(get16(&s[E131_ROOT_FLENGTH]), 0x7000 | (E131_SYNC_PACKET_SIZE - E131_ROOT_FLENGTH));
+  CHECK_EQ(get16(&s[E131_FRAME_FLENGTH]), 0x7000 | (E131_SYNC_PACKET_SIZE - E131_FRAME_FLENGTH));
+  CHECK_EQ(s[E131_ROOT_VECTOR+3], E131_VECTOR_ROOT_EXTENDED);
+  CHECK_EQ(s[E131_FRAME_VECTOR+3], E131_VECTOR_EXTENDED_SYNC);
+  CHECK_EQ(s[E131_SYNC_SEQ], seq);
+  CHECK_EQ(get16(&s[E131_SYNC_ADDR]), NETOUT_E131_SYNC_UNIVERSE);
+}
+
+// receive side validation of malformed E1.31 packets
+static void testE131Validation() {
+  NetOut out;
+  NetOutParams par = params(NETOUT_E131, false);
+  std::vector<uint8_t> frame(30, 0x55);
+  std::vector<Packet> packets;
+  CHECK(out.frame(par, frame.data(), 10, capture, &packets));
+  std::vector<uint8_t> d = packets[0].data;
+  CHECK_EQ(e131PacketProtocol(d.data(), d.size(), E131_DEFAULT_PORT), P_E131);
+  CHECK_EQ(e131PacketProtocol(d.data(), E131_DMP_DATA, E131_DEFAULT_PORT), P_NONE); // truncated before start code
+  CHECK_EQ(e131PacketProtocol(d.data(), 20, E131_DEFAULT_PORT), P_NONE);
+  CHECK_EQ(e131PacketProtocol(d.data(), 20, DDP_DEFAULT_PORT), P_DDP);               // anything on the DDP port
+  std::vector<uint8_t> bad = d;
+  bad[E131_DMP_DATA] = 0xCC;                                                         // not DMX start code
+  CHECK_EQ(e131PacketProtocol(bad.data(), bad.size(), E131_DEFAULT_PORT), P_NONE);
+  bad = d;
+  bad[E131_FRAME_VECTOR+3] = 0x03;
+  CHECK_EQ(e131PacketProtocol(bad.data(), bad.size(), E131_DEFAULT_PORT), P_NONE);
+  bad = d;
+  bad[E131_ROOT_ID] = 'X';                                                           // neither E1.31 nor Art-Net
+  CHECK_EQ(e131PacketProtocol(bad.data(), bad.size(), E131_DEFAULT_PORT), P_NONE);
+}
+
+// DDP and Art-Net packets are byte for byte those of the per-field write implementation, across
+// protocol switches (header rebuilt), brightness, RGBW and the shared sequence number
+static void testByteExact() {
+  NetOut out;
+  legacySequence = 0;
+  std::vector<uint8_t> frame;
+  struct { uint8_t type; bool rgbw; uint16_t pixels; uint8_t bri; } steps[] = {
+    { NETOUT_DDP,    false, 4000, 255 }, // 9 packets, partial last one
+    { NETOUT_DDP,    false,  480, 128 }, // exactly one full packet
+    { NETOUT_ARTNET, false, 4000, 255 },
+    { NETOUT_DDP,    true,  1000,  10 },
+    { NETOUT_ARTNET, true,   128,   0 },
+    { NETOUT_ARTNET, false,  171, 200 },
+    { NETOUT_E131,   false,  300, 255 }, // switches the buffer to E1.31 and back
+    { NETOUT_DDP,    false,    1,  77 },
+  };
+  for (int round = 0; round < 40; round++) { // wraps the DDP (16) and Art-Net (256) sequence
+    for (auto &st : steps) {
+      pattern(frame, st.pixels * (st.rgbw ? 4 : 3), round);
+      uint8_t lut[256];
+      for (int v = 0; v < 256; v++) lut[v] = scale8(v, st.bri);
+      NetOutParams par = params(st.type, st.rgbw, st.bri < 255 ? lut : nullptr);
+
+      std::vector<Packet> got;
+      CHECK(out.frame(par, frame.data(), st.pixels, capture, &got));
+      if (st.type == NETOUT_E131) continue;
+      std::vector<Packet> expected;
+      UdpStub udp;
+      udp._out = &expected;
+      legacyBroadcast(udp, st.type, st.pixels, frame.data(), st.bri, st.rgbw);
+      CHECK_EQ(got.size(), expected.size());
+      for (size_t i = 0; i < got.size() && i < expected.size(); i++) {
+        CHECK_EQ(got[i].port, expected[i].port);
+        CHECK(got[i].data == expected[i].data);
+      }
+    }
+  }
+
+  // E1.31 header of the first universe, byte for byte
+  static const uint8_t e131Header[E131_DMP_DATA + 1] = {
+    0x00, 0x10, 0x00, 0x00, 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00, // preamble, postamble, ACN ID
+    0x72, 0x6c, 0x00, 0x00, 0x00, 0x04,                                                     // root length 620, data vector
+    'W', 'L', 'E', 'D', '-', 's', 'A', 'C', 'N', '-', 0x24, 0x0A, 0xC4, 0x12, 0x34, 0x56,  // CID
+    0x72, 0x56, 0x00, 0x00, 0x00, 0x02,                                                     // frame length 598, data packet
+    'W', 'L', 'E', 'D', ' ', 't', 'e', 's', 't', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // source name
+    100, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01,                                                // priority, sync, seq 1, options, universe 1
+    0x72, 0x09, 0x02, 0xa1, 0x00, 0x00, 0x00, 0x01, 0x01, 0xff, 0x00                        // DMP length 521, 511 values, start code
+  };
+  NetOut e131;
+  std::vector<Packet> got;
+  pattern(frame, 600, 0);
+  CHECK(e131.frame(params(NETOUT_E131, false), frame.data(), 200, capture, &got));
+  CHECK_EQ(got.size(), 2);
+  CHECK_EQ(got[0].data.size(), E131_DMP_DATA + 1 + 510);
+  CHECK(memcmp(got[0].data.data(), e131Header, sizeof(e131Header)) == 0);
+  CHECK(memcmp(got[0].data.data() + sizeof(e131Header), frame.data(), 510) == 0);
+}
+
+// ArtSync and DDP push
+static void testSync() {
+  NetOut out;
+  std::vector<Packet> got;
+  CHECK(out.sync(params(NETOUT_DDP, false), capture, &got));
+  CHECK(out.sync(params(NETOUT_ARTNET, false), capture, &got));
+  CHECK(!out.sync(params(3, false), capture, &got));
+  CHECK_EQ(got.size(), 2);
+  const std::vector<uint8_t> push = { 0x41, 0x00, 0x00, 0x01, 0, 0, 0, 0, 0, 0 };
+  const std::vector<uint8_t> artSync = { 'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x52, 0x00, 0x0e, 0x00, 0x00 };
+  CHECK(got[0].port == DDP_DEFAULT_PORT && got[0].data == push);
+  CHECK(got[1].port == ARTNET_DEFAULT_PORT && got[1].data == artSync);
+  CHECK_EQ(e131PacketProtocol(artSync.data(), artSync.size(), ARTNET_DEFAULT_PORT), P_ARTNET);
+}
+
+// 4000 pixel network bus: buffer assembly and one write per packet against the per-channel writes
+static void benchmark(uint8_t type, uint8_t bri) {
+  const uint16_t pixels = 4000;
+  const int frames = 300;
+  std::vector<uint8_t> frame;
+  pattern(frame, pixels * 3, 1);
+  uint8_t lut[256];
+  NetOut out;
+  UdpStub udp;
+
+  uint64_t t = hostMicros();
+  for (int f = 0; f < frames; f++) {
+    NetOutParams par = params(type, false);
+    if (bri < 255) { // built per frame as in realtimeBroadcast()
+      for (int v = 0; v < 256; v++) lut[v] = scale8(v, bri);
+      par.lut = lut;
+    }
+    out.frame(par, frame.data(), pixels, sendStub, &udp);
+  }
+  const uint64_t builder = hostMicros() - t;
+  const size_t packets = udp._packets / frames;
+
+  t = hostMicros();
+  for (int f = 0; f < frames; f++) legacyBroadcast(udp, type, pixels, frame.data(), bri, false);
+  const uint64_t legacy = hostMicros() - t;
+
+  printf("  %-6s 4000 px, bri %3u, %zu packets/frame: %6.1f us/frame (%5.1f Mpx/s), per-channel writes %6.1f us/frame, %.1fx\n",
+         type == NETOUT_DDP ? "DDP" : "ArtNet", bri, packets, (double)builder / frames, (double)frames * pixels / (builder ? builder : 1),
+         (double)legacy / frames, (double)legacy / (builder ? builder : 1));
+}
+
+int main() {
+  uint8_t lut[256];
+  for (int v = 0; v < 256; v++) lut[v] = (v * (1 + 128)) >> 8; // like scale8(v, 128)
+  testE131(false, 170, nullptr);  // exactly one universe
+  testE131(false, 1000, nullptr);
+  testE131(true, 1000, lut);
+  testE131(false, 1, lut);
+  testE131Validation();
+  testByteExact();
+  testSync();
+  benchmark(NETOUT_DDP, 255);
+  benchmark(NETOUT_DDP, 128);
+  benchmark(NETOUT_ARTNET, 128);
+  return hostTestResult("net_out");
+}
@@ -0,0 +1,217 @@
+/*
+ * DZ realtime codec: frames encoded with RtzEncoder are decoded packet by packet with rtzDecode()
+ * and must match the quantized source exactly. Prints compression ratios against DNRGB/DNRGBW packets
+ * and encode/decode throughput.
+ */
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "host_test.h"
+#include "realtime_codec.h"
+
+#define LEN       2000
+#define MAX_SIZE  1400
+#define FRAMES    200
+
+enum Content { CHASE, GRADIENT, TWINKLE };
+static const char *contentName[] = { "chase", "gradient", "twinkle" };
+
+struct Receiver {
+  uint32_t pixels[LEN];
+  size_t   bytes;
+  size_t   packets;
+  size_t   pushes;
+  bool     keyframe;  // last packet was part of a keyframe
+  bool     skips;     // a keyframe packet contained SKIP ops
+  bool     oversized; // a packet exceeded MAX_SIZE
+  bool     malformed; // rtzDecode() rejected a packet
+};
+
+static uint32_t rng = 1;
+static uint32_t random32() { // deterministic across platforms, unlike rand()
+  rng = rng * 1664525 + 1013904223;
+  return rng >> 8;
+}
+
+static void onSpan(uint16_t index, const uint32_t *colors, uint16_t count, void *arg) {
+  Receiver *rx = (Receiver*)arg;
+  if (index + count <= LEN) memcpy(rx->pixels + index, colors, count * sizeof(uint32_t));
+}
+
+static void onPacket(const uint8_t *packet, size_t size, void *arg) {
+  Receiver *rx = (Receiver*)arg;
+  rx->bytes += size;
+  rx->packets++;
+  if (size > MAX_SIZE) rx->oversized = true;
+  if (packet[2] & RTZ_FLAG_PUSH) rx->pushes++;
+  rx->keyframe = packet[2] & RTZ_FLAG_KEYFRAME;
+  if (rx->keyframe) { // walk the ops, keyframes must not refer to the previous frame
+    const uint8_t cs = rtzColorSize(packet[2]);
+    for (size_t pos = RTZ_HEADER_SIZE; pos < size;) {
+      uint8_t op = packet[pos++];
+      if ((op & RTZ_OP_MASK) == RTZ_OP_SKIP) rx->skips = true;
+      pos += ((op & RTZ_OP_MASK) == RTZ_OP_LITERAL ? (op & 0x3F) + 1 : (op & RTZ_OP_MASK) == RTZ_OP_RUN) * cs;
+    }
+  }
+  if (rtzDecode(packet, size, onSpan, rx) < 0) rx->malformed = true;
+}
+
+static void storePacket(const uint8_t *packet, size_t size, void *arg) {
+  ((std::vector<std::vector<uint8_t>>*)arg)->emplace_back(packet, packet + size);
+}
+
+static void render(uint32_t *f, Content content, int fr, bool rgbw) {
+  for (int i = 0; i < LEN; i++) {
+    uint8_t r = 0, g = 0, b = 0, w = 0;
+    switch (content) {
+      case CHASE: { // short comet on a dark background
+        int d = abs((fr * 7) % LEN - i);
+        if (d < 40) { r = 255 - d * 6; b = d * 6; w = rgbw ? d : 0; }
+      } break;
+      case GRADIENT: { // slowly moving rainbow over the whole strip
+        double h = i * 0.01 + fr * 0.02;
+        r = 127 + 127 * sin(h); g = 127 + 127 * sin(h + 2.09); b = 127 + 127 * sin(h + 4.19);
+      } break;
+      case TWINKLE: { // sparse random changes
+        uint32_t x = f[i];
+        if (fr == 0 || random32() % 50 == 0) x = random32() % 3 == 0 ? random32() : 0;
+        if (!rgbw) x &= 0xFFFFFF;
+        f[i] = x;
+        continue;
+      }
+    }
+    f[i] = ((uint32_t)w << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+}
+
+// returns the compression ratio against DNRGB / DNRGBW packets of at most MAX_SIZE bytes
+static double roundTrip(uint8_t depth, bool rgbw, Content content) {
+  static Receiver rx;
+  static uint32_t frame[LEN];
+  memset(&rx, 0, sizeof(rx));
+  memset(frame, 0, sizeof(frame));
+  rng = 1;
+  RtzEncoder enc;
+  CHECK(enc.begin(LEN, rgbw, depth, 50));
+  const uint8_t flags = (rgbw ? RTZ_FLAG_RGBW : 0) | (depth << RTZ_DEPTH_SHIFT);
+  uint8_t buffer[MAX_SIZE];
+  size_t mismatches = 0;
+
+  for (int fr = 0; fr < FRAMES; fr++) {
+    render(frame, content, fr, rgbw);
+    size_t pushes = rx.pushes, bytes = rx.bytes;
+    CHECK_EQ(enc.encode(frame, 2, buffer, sizeof(buffer), onPacket, &rx), rx.bytes - bytes);
+    CHECK_EQ(rx.pushes, pushes + 1); // one push per frame, on its last packet
+    CHECK_EQ(rx.keyframe, fr % 50 == 0);
+    for (int i = 0; i < LEN; i++) if (rx.pixels[i] != rtzQuantize(frame[i], flags)) mismatches++;
+  }
+  CHECK_EQ(mismatches, 0);
+  CHECK(!rx.skips);
+  CHECK(!rx.oversized);
+  CHECK(!rx.malformed);
+
+  const size_t cs = rgbw ? 4 : 3, header = 4;
+  const size_t perPacket = (MAX_SIZE - header) / cs;
+  const size_t raw = (size_t)FRAMES * (LEN * cs + (LEN + perPacket - 1) / perPacket * header);
+  const double ratio = (double)raw / rx.bytes;
+  printf("  %-4s depth %u %-8s: %5zu bytes/frame, %.2f packets/frame, %5.1fx\n", rgbw ? "RGBW" : "RGB", depth,
+         contentName[content], rx.bytes / FRAMES, (double)rx.packets / FRAMES, ratio);
+  return ratio;
+}
+
+// packets that do not add up are rejected before anything is written
+static void testMalformed() {
+  static Receiver rx;
+  memset(&rx, 0, sizeof(rx));
+  const uint8_t ok[] = { RTZ_PROTOCOL, 2, RTZ_FLAG_KEYFRAME | RTZ_FLAG_PUSH, 0, 0, 10,
+                         RTZ_OP_RUN | 4, 1, 2, 3, RTZ_OP_LITERAL | 1, 4, 5, 6, 7, 8, 9 };
+  CHECK_EQ(rtzDecode(ok, sizeof(ok), onSpan, &rx), 7);
+  CHECK_EQ(rx.pixels[10], 0x010203);
+  CHECK_EQ(rx.pixels[14], 0x010203);
+  CHECK_EQ(rx.pixels[15], 0x040506);
+  CHECK_EQ(rx.pixels[16], 0x070809);
+
+  memset(&rx, 0, sizeof(rx));
+  CHECK_EQ(rtzDecode(ok, sizeof(ok) - 1, onSpan, &rx), -1); // truncated literal
+  CHECK_EQ(rx.pixels[10], 0);                                // leading run not applied
+  CHECK_EQ(rtzDecode(ok, RTZ_HEADER_SIZE - 1, onSpan, &rx), -1);
+
+  uint8_t bad[sizeof(ok)];
+  memcpy(bad, ok, sizeof(ok));
+  bad[0] = 4; // DNRGB
+  CHECK_EQ(rtzDecode(bad, sizeof(bad), onSpan, &rx), -1);
+  memcpy(bad, ok, sizeof(ok));
+  bad[2] |= 3 << RTZ_DEPTH_SHIFT; // reserved depth
+  CHECK_EQ(rtzDecode(bad, sizeof(bad), onSpan, &rx), -1);
+  memcpy(bad, ok, sizeof(ok));
+  bad[6] = 0xC0 | 4; // reserved op
+  CHECK_EQ(rtzDecode(bad, sizeof(bad), onSpan, &rx), -1);
+
+  // ops running past index 65535 are clipped
+  const uint8_t end[] = { RTZ_PROTOCOL, 2, RTZ_FLAG_PUSH, 0, 0xFF, 0xFE, RTZ_OP_RUN | 9, 1, 2, 3 };
+  CHECK_EQ(rtzDecode(end, sizeof(end), onSpan, &rx), 2);
+}
+
+// a receiver that missed packets shows the source again from the next keyframe on
+static void testRecovery() {
+  static Receiver rx;
+  static uint32_t frame[LEN];
+  memset(&rx, 0, sizeof(rx));
+  memset(frame, 0, sizeof(frame));
+  RtzEncoder enc;
+  CHECK(enc.begin(LEN, false, RTZ_DEPTH_8, 10));
+  uint8_t buffer[MAX_SIZE];
+  for (int fr = 0; fr < 5; fr++) {
+    render(frame, CHASE, fr, false);
+    enc.encode(frame, 2, buffer, sizeof(buffer), onPacket, &rx);
+  }
+  memset(rx.pixels, 0, sizeof(rx.pixels)); // lost state
+  enc.forceKeyframe();
+  render(frame, GRADIENT, 5, false);
+  enc.encode(frame, 2, buffer, sizeof(buffer), onPacket, &rx);
+  CHECK(rx.keyframe);
+  CHECK(memcmp(rx.pixels, frame, sizeof(frame)) == 0);
+}
+
+static void benchmark() {
+  static Receiver rx;
+  static uint32_t frame[LEN];
+  memset(&rx, 0, sizeof(rx));
+  RtzEncoder enc;
+  CHECK(enc.begin(LEN, false, RTZ_DEPTH_8, 50));
+  uint8_t buffer[MAX_SIZE];
+  std::vector<std::vector<uint8_t>> packets;
+  const int frames = 500;
+
+  uint64_t t = hostMicros();
+  for (int fr = 0; fr < frames; fr++) {
+    render(frame, GRADIENT, fr, false);
+    enc.encode(frame, 2, buffer, sizeof(buffer), storePacket, &packets);
+  }
+  const uint64_t encodeTime = hostMicros() - t;
+
+  t = hostMicros();
+  for (const std::vector<uint8_t> &p : packets) rtzDecode(p.data(), p.size(), onSpan, &rx);
+  const uint64_t decodeTime = hostMicros() - t;
+  printf("  benchmark: %d frames of %d pixels (gradient, incl. rendering), encode %.1f Mpx/s, decode %.1f Mpx/s\n",
+         frames, LEN, (double)frames * LEN / (encodeTime ? encodeTime : 1), (double)frames * LEN / (decodeTime ? decodeTime : 1));
+}
+
+int main() {
+  static const double minRatio[3][3] = { // [depth][content], RGB, ~10% below the measured figures
+    {  20.0, 0.95, 25.0 },
+    {  28.0, 2.5,  30.0 },
+    {  90.0, 24.0, 40.0 },
+  };
+  for (uint8_t depth = RTZ_DEPTH_8; depth <= RTZ_DEPTH_8BPP; depth++) {
+    for (int c = CHASE; c <= TWINKLE; c++) {
+      double ratio = roundTrip(depth, false, (Content)c);
+      CHECK(ratio >= minRatio[depth][c]);
+      roundTrip(depth, true, (Content)c);
+    }
+  }
+  testMalformed();
+  testRecovery();
+  benchmark();
+  return hostTestResult("realtime_codec");
+}
@@ -0,0 +1,181 @@
+/*
+ * SerialPixelParser: recorded Adalight/TPM2 streams are replayed split into blocks of every size from
+ * 1 byte up to the whole stream. Every split has to give the same frames and commands as the stream
+ * fed in one piece. Pixels go into a stand-in pixel buffer and each commit records its contents.
+ */
+#include <string>
+#include <vector>
+#include "host_test.h"
+#include "serial_parser.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+struct Sink {
+  Bytes              pixels = Bytes(3 * 300, 0);
+  std::vector<Bytes> frames;   // pixel buffer at each commit
+  std::string        log;      // 'F' frame, 'P' ping, command bytes
+  uint32_t           calls = 0;
+};
+
+static void onPixels(uint16_t index, const uint8_t *rgb, uint16_t count, void *arg) {
+  Sink *s = (Sink*)arg;
+  CHECK((index + count) * 3 <= s->pixels.size());
+  for (uint32_t i = 0; i < count * 3u; i++) s->pixels[index * 3 + i] = rgb[i];
+  s->calls++;
+}
+
+static void onFrame(void *arg) {
+  Sink *s = (Sink*)arg;
+  s->frames.push_back(s->pixels);
+  s->log += 'F';
+}
+
+static void onPing(void *arg) {
+  ((Sink*)arg)->log += 'P';
+}
+
+static Bytes pixelData(uint16_t count, uint8_t seed) {
+  Bytes d(count * 3);
+  for (size_t i = 0; i < d.size(); i++) d[i] = uint8_t(i * 7 + seed);
+  return d;
+}
+
+static void adalight(Bytes &out, uint16_t count, uint8_t seed, bool badCheck = false) {
+  uint8_t hi = (count - 1) >> 8, lo = (count - 1) & 0xFF;
+  out.insert(out.end(), {'A', 'd', 'a', hi, lo, uint8_t(hi ^ lo ^ 0x55 ^ (badCheck ? 1 : 0))});
+  Bytes d = pixelData(count, seed);
+  out.insert(out.end(), d.begin(), d.end());
+}
+
+static void tpm2(Bytes &out, uint16_t count, uint8_t seed, uint8_t end = 0x36) {
+  uint16_t size = count * 3;
+  out.insert(out.end(), {0xC9, 0xDA, uint8_t(size >> 8), uint8_t(size & 0xFF)});
+  Bytes d = pixelData(count, seed);
+  out.insert(out.end(), d.begin(), d.end());
+  out.push_back(end);
+}
+
+// what handleSerial() does: feed blocks, a byte the parser leaves is a command and is skipped by the caller
+static Sink replay(const Bytes &stream, size_t block) {
+  Sink s;
+  SerialPixelParser parser(onPixels, onFrame, onPing, &s);
+  size_t pos = 0;
+  while (pos < stream.size()) {
+    size_t n = stream.size() - pos;
+    if (n > block) n = block;
+    size_t used = parser.feed(stream.data() + pos, n);
+    CHECK(used <= n);
+    pos += used;
+    if (used < n) {
+      CHECK(parser.isIdle());
+      s.log += char(stream[pos++]); // command byte
+    }
+  }
+  return s;
+}
+
+// the same result for every block size
+static Sink replayAllSplits(const Bytes &stream) {
+  Sink whole = replay(stream, stream.size());
+  for (size_t block = 1; block < stream.size(); block++) {
+    Sink s = replay(stream, block);
+    if (s.log != whole.log || s.frames != whole.frames) {
+      printf("  block size %zu differs\n", block);
+      CHECK(false);
+      break;
+    }
+  }
+  return whole;
+}
+
+static Bytes framePixels(uint16_t count, uint8_t seed, const Bytes &before) {
+  Bytes f = before;
+  Bytes d = pixelData(count, seed);
+  std::copy(d.begin(), d.end(), f.begin());
+  return f;
+}
+
+// frames of both protocols mixed with command bytes and pings
+static void testMixedStream() {
+  Bytes st;
+  st.push_back('v');
+  adalight(st, 10, 1);
+  tpm2(st, 20, 2);
+  st.insert(st.end(), {0xC9, 0xAA});      // ping
+  st.push_back('L');
+  adalight(st, 256, 3);                    // count hi byte set
+  tpm2(st, 1, 4);
+  st.insert(st.end(), {'O', 'o', 0xB5});
+  Sink s = replayAllSplits(st);
+  CHECK(s.log == "vFFPLFFOo\xB5");
+  CHECK_EQ(s.frames.size(), 4);
+  Bytes zero(3 * 300, 0);
+  Bytes f0 = framePixels(10, 1, zero);
+  Bytes f1 = framePixels(20, 2, f0);
+  Bytes f2 = framePixels(256, 3, f1);
+  Bytes f3 = framePixels(1, 4, f2);
+  CHECK(s.frames[0] == f0);
+  CHECK(s.frames[1] == f1);
+  CHECK(s.frames[2] == f2);
+  CHECK(s.frames[3] == f3);
+}
+
+// broken frames are not committed, the parser picks up the next good one
+static void testBrokenFrames() {
+  Bytes st;
+  adalight(st, 5, 1, true);                // bad checksum: header dropped, payload bytes are commands
+  tpm2(st, 5, 2, 0x00);                    // missing end byte: pixels written, frame not shown
+  st.insert(st.end(), {0xC9, 0xDA, 0x00, 0x04}); // size not a multiple of 3
+  st.insert(st.end(), {0xC9, 0xDA, 0x00, 0x00}); // empty frame
+  st.insert(st.end(), {'A', 'd', 'x'});    // broken magic
+  st.insert(st.end(), {0xC9, 0x55});       // unsupported TPM2 type
+  adalight(st, 3, 9);
+  Sink s = replayAllSplits(st);
+  CHECK_EQ(s.frames.size(), 1);
+  CHECK_EQ(s.log.back(), 'F');
+  CHECK_EQ(s.log.find('F'), s.log.size() - 1);
+  Bytes zero(3 * 300, 0);
+  Bytes expect = framePixels(3, 9, framePixels(5, 2, zero)); // dropped TPM2 pixels stay in the buffer
+  CHECK(s.frames[0] == expect);
+}
+
+// pixels are handed on in runs, not one call per pixel, when the block holds more than one
+static void testBlockRuns() {
+  Bytes st;
+  adalight(st, 64, 1);
+  Sink s = replay(st, 6 + 64 * 3);
+  CHECK_EQ(s.calls, 1);
+  s = replay(st, 64); // pixels split between blocks are completed from the next block
+  CHECK_EQ(s.frames.size(), 1);
+  CHECK(s.frames[0] == framePixels(64, 1, Bytes(3 * 300, 0)));
+  CHECK(s.calls < 64);
+}
+
+// payloadLeft() tells the caller how much it may read without running into a command byte
+static void testPayloadLeft() {
+  Sink s;
+  SerialPixelParser parser(onPixels, onFrame, onPing, &s);
+  Bytes st;
+  tpm2(st, 4, 1);
+  CHECK_EQ(parser.feed(st.data(), 4), 4);
+  CHECK_EQ(parser.payloadLeft(), 12);
+  CHECK_EQ(parser.feed(st.data() + 4, 5), 5);
+  CHECK_EQ(parser.payloadLeft(), 7);
+  CHECK_EQ(parser.feed(st.data() + 9, 7), 7);
+  CHECK_EQ(parser.payloadLeft(), 0);
+  CHECK(!parser.isIdle());                 // end byte pending
+  CHECK(s.frames.empty());
+  CHECK_EQ(parser.feed(st.data() + 16, 1), 1);
+  CHECK(parser.isIdle());
+  CHECK_EQ(s.frames.size(), 1);
+  const uint8_t cmd = 'l';
+  CHECK_EQ(parser.feed(&cmd, 1), 0);
+}
+
+int main() {
+  testMixedStream();
+  testBrokenFrames();
+  testBlockRuns();
+  testPayloadLeft();
+  return hostTestResult("serial_parser");
+}
@@ -0,0 +1,148 @@
+/*
+ * SpscRing: a producer thread stands in for the network task, the main thread for the main loop.
+ * Every slot carries its sequence number and a length and fill byte derived from it, so reordering,
+ * torn slots (data read before it was published) and lost slots show up as mismatches.
+ */
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include "host_test.h"
+#include "spsc_ring.h"
+
+#define SLOT_SIZE 64
+
+static uint16_t slotLen(uint32_t seq) { return 4 + seq % (SLOT_SIZE - 4 + 1); }
+
+static void fill(uint8_t *slot, uint32_t seq) {
+  memcpy(slot, &seq, 4);
+  memset(slot + 4, (uint8_t)(seq * 7), slotLen(seq) - 4);
+}
+
+static bool verify(const uint8_t *slot, uint16_t len, uint32_t seq) {
+  uint32_t v;
+  memcpy(&v, slot, 4);
+  if (v != seq || len != slotLen(seq)) return false;
+  for (uint16_t i = 4; i < len; i++) if (slot[i] != (uint8_t)(seq * 7)) return false;
+  return true;
+}
+
+struct Producer {
+  SpscRing *ring;
+  uint32_t count;
+  bool     retry;   // wait for a free slot instead of dropping
+  std::atomic<uint32_t> sent{0}; // published, read by the consumer to see when the producer is done
+};
+
+static void produce(Producer *p) {
+  for (uint32_t seq = 0; seq < p->count;) {
+    uint8_t *slot = p->ring->acquire();
+    if (!slot) {
+      if (!p->retry) seq++; // dropped, as the network callback does
+      std::this_thread::yield();
+      continue;
+    }
+    fill(slot, seq);
+    p->ring->publish(slotLen(seq));
+    p->sent++;
+    seq++;
+  }
+}
+
+static void testSingleThread() {
+  SpscRing ring;
+  CHECK(!ring.isActive());
+  CHECK(!ring.begin(0, SLOT_SIZE));
+  CHECK(ring.begin(6, SLOT_SIZE));
+  CHECK_EQ(ring.getSlots(), 4); // rounded down to a power of two
+  uint16_t len;
+  CHECK(ring.peek(len) == nullptr);
+
+  // fill, overflow, drain; repeated so the free running indices wrap the slots several times
+  uint32_t seq = 0;
+  for (int round = 0; round < 5; round++) {
+    for (int i = 0; i < 4; i++) {
+      uint8_t *slot = ring.acquire();
+      CHECK(slot != nullptr);
+      if (!slot) return;
+      fill(slot, seq + i);
+      ring.publish(slotLen(seq + i));
+    }
+    CHECK(ring.acquire() == nullptr);
+    CHECK_EQ(ring.getDropped(), round + 1);
+    CHECK_EQ(ring.getQueued(), 4);
+    for (int i = 0; i < 4; i++, seq++) {
+      const uint8_t *slot = ring.peek(len);
+      CHECK(slot && verify(slot, len, seq));
+      ring.pop();
+    }
+    CHECK_EQ(ring.getQueued(), 0);
+  }
+  ring.end();
+  CHECK(!ring.isActive());
+}
+
+// producer waiting for free slots: everything arrives, in order and intact
+static void testThreads() {
+  SpscRing ring;
+  CHECK(ring.begin(8, SLOT_SIZE));
+  Producer p;
+  p.ring = &ring;
+  p.count = 1000000;
+  p.retry = true;
+  uint64_t t = hostMicros();
+  std::thread producer(produce, &p);
+  uint32_t seq = 0, bad = 0;
+  while (seq < p.count) {
+    uint16_t len;
+    const uint8_t *slot = ring.peek(len);
+    if (!slot) { std::this_thread::yield(); continue; } // the host may have a single core
+    if (!verify(slot, len, seq)) bad++;
+    ring.pop();
+    seq++;
+  }
+  producer.join();
+  t = hostMicros() - t;
+  printf("  %u slots through 8, %.1f M/s\n", seq, (double)seq / (t ? t : 1));
+  CHECK_EQ(bad, 0);
+  CHECK_EQ(p.sent, p.count);
+  CHECK_EQ(ring.getQueued(), 0);
+}
+
+// producer dropping on a full ring: what arrives is in order and intact, the rest is counted
+static void testDrops() {
+  SpscRing ring;
+  CHECK(ring.begin(4, SLOT_SIZE));
+  Producer p;
+  p.ring = &ring;
+  p.count = 200000;
+  p.retry = false;
+  std::thread producer(produce, &p);
+  uint32_t received = 0, bad = 0, last = 0;
+  bool done = false;
+  while (!done) {
+    done = p.sent + ring.getDropped() == p.count; // check before draining so nothing is left behind
+    uint16_t len;
+    const uint8_t *slot;
+    while ((slot = ring.peek(len))) {
+      uint32_t seq;
+      memcpy(&seq, slot, 4);
+      if ((received && seq <= last) || !verify(slot, len, seq)) bad++;
+      last = seq;
+      received++;
+      ring.pop();
+    }
+    std::this_thread::yield();
+  }
+  producer.join();
+  printf("  %u received, %u dropped\n", received, ring.getDropped());
+  CHECK_EQ(bad, 0);
+  CHECK_EQ(received, p.sent);
+  CHECK_EQ(received + ring.getDropped(), p.count);
+}
+
+int main() {
+  testSingleThread();
+  testThreads();
+  testDrops();
+  return hostTestResult("spsc_ring");
+}
@@ -0,0 +1,140 @@
+/*
+ * UdpDrain: receive passes over a stand-in socket queue with a fake microsecond clock. Handling a
+ * packet costs a fixed time; realtime packets write their frame number into a stand-in pixel buffer,
+ * show() records what was in it.
+ */
+#include <deque>
+#include <vector>
+#include "host_test.h"
+#include "udp_drain.h"
+
+enum Kind { NOTIFY, FRAME, PART }; // notifier sync, single packet frame, packet of a multi packet frame
+
+struct Datagram {
+  Kind     kind;
+  uint32_t frame;
+  bool     last; // PART: last packet of the frame (push)
+};
+
+struct Socket {
+  std::deque<Datagram>  queue;
+  uint32_t              cost = 300; // us per packet
+  uint32_t              pixels = 0; // frame number in the pixel buffer
+  std::vector<uint32_t> shown;
+  UdpDrain             *drain = nullptr;
+};
+
+static uint32_t fakeClock = 0;
+static uint32_t clockMicros() { return fakeClock; }
+
+static bool handle(void *arg) {
+  Socket *s = (Socket*)arg;
+  if (s->queue.empty()) return false;
+  Datagram d = s->queue.front();
+  s->queue.pop_front();
+  fakeClock += s->cost;
+  if (d.kind != NOTIFY) s->pixels = d.frame;
+  if (d.kind == FRAME || (d.kind == PART && d.last)) s->drain->frameReady();
+  return true;
+}
+
+static void show(void *arg) {
+  Socket *s = (Socket*)arg;
+  s->shown.push_back(s->pixels);
+}
+
+// frames that piled up while the loop was busy are written in order, only the newest is shown
+static void testCoalescing() {
+  Socket s;
+  UdpDrain drain(handle, show, clockMicros, &s);
+  s.drain = &drain;
+  for (uint32_t f = 1; f <= 5; f++) s.queue.push_back({FRAME, f, true});
+  s.queue.push_back({NOTIFY, 0, false});
+  CHECK_EQ(drain.drain(5000), 6);
+  CHECK(s.queue.empty());
+  CHECK_EQ(s.shown.size(), 1);
+  CHECK_EQ(s.shown.back(), 5);
+  CHECK_EQ(drain.getStats().superseded, 4);
+  CHECK_EQ(drain.getStats().exceeded, 0);
+
+  // empty socket, or only non-frame packets: no show
+  CHECK_EQ(drain.drain(5000), 0);
+  s.queue.push_back({NOTIFY, 0, false});
+  CHECK_EQ(drain.drain(5000), 1);
+  CHECK_EQ(s.shown.size(), 1);
+  CHECK_EQ(drain.getStats().handled, 7);
+}
+
+// a backlog larger than the budget is spread over several passes, each showing what it completed
+static void testBudget(uint32_t start) {
+  Socket s;
+  UdpDrain drain(handle, show, clockMicros, &s);
+  s.drain = &drain;
+  fakeClock = start;
+  for (uint32_t f = 1; f <= 40; f++) s.queue.push_back({FRAME, f, true});
+  // 300 us per packet, 5 ms budget: the pass ends after the packet that reaches the budget
+  CHECK_EQ(drain.drain(5000), 17);
+  CHECK_EQ(drain.getStats().exceeded, 1);
+  CHECK_EQ(s.shown.size(), 1);
+  CHECK_EQ(s.shown.back(), 17);
+  CHECK_EQ(drain.drain(5000), 17);
+  CHECK_EQ(drain.drain(5000), 6); // rest, budget not reached
+  CHECK_EQ(drain.getStats().exceeded, 2);
+  CHECK(s.shown == std::vector<uint32_t>({17, 34, 40}));
+  CHECK_EQ(drain.getStats().superseded, 37);
+  CHECK_EQ(drain.getStats().handled, 40);
+
+  // budget of 1 ms against slow packets: at least one packet per pass, so progress is always made
+  s.cost = 2000;
+  s.queue.push_back({FRAME, 41, true});
+  s.queue.push_back({FRAME, 42, true});
+  CHECK_EQ(drain.drain(1000), 1);
+  CHECK_EQ(drain.drain(1000), 1);
+  CHECK_EQ(s.shown.back(), 42);
+}
+
+// a frame split over several packets is only shown once its last packet has arrived
+static void testMultiPacketFrame() {
+  Socket s;
+  UdpDrain drain(handle, show, clockMicros, &s);
+  s.drain = &drain;
+  for (uint32_t p = 0; p < 20; p++) s.queue.push_back({PART, 1, p == 19});
+  CHECK_EQ(drain.drain(3000), 10); // budget ends the pass halfway through the frame
+  CHECK(s.shown.empty());
+  CHECK_EQ(drain.drain(3000), 10);
+  CHECK_EQ(s.shown.size(), 1);
+  CHECK_EQ(s.shown.back(), 1);
+  CHECK_EQ(drain.getStats().superseded, 0);
+}
+
+// sockets draining in one pass instead of one packet per loop: with a 20 ms loop (long show) and a
+// 60 fps sender, one packet per loop falls further behind every loop, a budgeted pass keeps up
+static void testBacklog() {
+  for (int perLoop = 0; perLoop < 2; perLoop++) {
+    Socket s;
+    s.cost = 100;
+    UdpDrain drain(handle, show, clockMicros, &s);
+    s.drain = &drain;
+    fakeClock = 0;
+    uint32_t sent = 0, next = 0;
+    while (fakeClock < 2000000) { // 2 s
+      while (next <= fakeClock) { s.queue.push_back({FRAME, ++sent, true}); next += 16667; }
+      if (perLoop) { if (handle(&s)) show(&s); }
+      else         drain.drain(5000);
+      fakeClock += 20000; // rest of the loop
+    }
+    printf("  %-20s %3zu frames queued after 2 s, newest shown %u of %u\n", perLoop ? "one packet per loop:" : "drained per loop:",
+           s.queue.size(), s.shown.empty() ? 0 : s.shown.back(), sent);
+    if (perLoop) CHECK(s.queue.size() > 10);
+    else         CHECK(s.queue.empty() && s.shown.back() == sent);
+  }
+}
+
+int main() {
+  testCoalescing();
+  testBudget(0);
+  testBudget(UINT32_MAX - 7000); // micros() wrapping during a pass
+  testMultiPacketFrame();
+  testBacklog();
+  return hostTestResult("udp_drain");
+}
@@ -1254,12 +1254,7 @@ uint16_t mode_rain() {
       SEGENV.aux0 = (SEGENV.aux0 % width) + (SEGENV.aux0 / width + 1) * width;
       SEGENV.aux1 = (SEGENV.aux1 % width) + (SEGENV.aux1 / width + 1) * width;
     } else {
-      //shift all leds left
-      uint32_t ctemp = SEGMENT.getPixelColor(0);
-      for (int i = 0; i < SEGLEN - 1; i++) {
-        SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1));
-      }
-      SEGMENT.setPixelColor(SEGLEN -1, ctemp); // wrap around
+      SEGMENT.shift(1, true); // shift all leds left, wrap around
       SEGENV.aux0++;  // increase spark index
       SEGENV.aux1++;
     }
@@ -1972,50 +1967,94 @@ static const char _data_FX_MODE_PALETTE[] PROGMEM = "Palette@Cycle speed;;!;;c3=
 // There are two main parameters you can play with to control the look and
 // feel of your fire: COOLING (used in step 1 above) (Speed = COOLING), and SPARKING (used
 // in step 3 above) (Effect Intensity = Sparking).
+//
+// Each (virtual) strip can be split into several flames (Custom 1), each flame being
+// an independent heat field running along its part of the strip (odd flames run backwards).
+#define FIRE2012_LUT_SIZE 241 // heat is capped at 240 when mapped to palette
+
+// Step 1. Cool down every cell a little (4 cells per 32 bit random number)
+static void fire2012_cool(byte* heat, int len, uint8_t coolRange, uint8_t ignition) {
+  uint32_t rnd = 0;
+  for (int i = 0; i < len; i++) {
+    if ((i & 3) == 0) rnd = ((uint32_t)random16() << 16) | random16();
+    uint8_t cool = ((rnd & 0xFF) * coolRange) >> 8; // same as random8(coolRange)
+    rnd >>= 8;
+    uint8_t minTemp = (i<ignition) ? (ignition-i)/4 + 16 : 0;  // should not become black in ignition area
+    uint8_t temp = qsub8(heat[i], cool);
+    heat[i] = temp<minTemp ? minTemp : temp;
+  }
+}
+
+// Step 2. Heat from each cell drifts 'up' and diffuses a little (heat[k] = (heat[k-1] + 2*heat[k-2]) / 3)
+static void fire2012_drift(byte* heat, int len) {
+  if (len < 3) return;
+  uint16_t h1 = heat[len-2], h2 = heat[len-3]; // heat[k-1] and heat[k-2] carried in registers
+  for (int k = len-1; k > 2; k--) {
+    heat[k] = (h1 + (h2<<1)) / 3;
+    h1 = h2;
+    h2 = heat[k-3];
+  }
+  heat[2] = (h1 + (h2<<1)) / 3;
+}
+
+// Step 3. Randomly ignite new 'sparks' of heat near the bottom
+static void fire2012_spark(byte* heat, uint8_t ignition) {
+  if (random8() <= SEGMENT.intensity) {
+    uint8_t y = random8(ignition);
+    uint8_t boost = (17+SEGMENT.custom3) * (ignition - y/2) / ignition; // integer math!
+    heat[y] = qadd8(heat[y], random8(96+2*boost,207+boost));
+  }
+}
+
 uint16_t mode_fire_2012() {
   if (SEGLEN == 1) return mode_static();
   const uint16_t strips = SEGMENT.nrOfVStrips();
-  if (!SEGENV.allocateData(strips * SEGLEN)) return mode_static(); //allocation failed
-  byte* heat = SEGENV.data;
+  const uint16_t heatSize = strips * SEGLEN;
+  // palette lookup table pays off once there are more heat cells than palette entries; if it does not fit
+  // next to the heat cells run without it (and stay so, retrying would reset the heat every frame)
+  bool useLUT = heatSize > FIRE2012_LUT_SIZE && !(SEGENV.data && SEGENV.dataSize() == heatSize);
+  if (useLUT && !SEGENV.allocateData(FIRE2012_LUT_SIZE * sizeof(CRGB) + heatSize)) useLUT = false;
+  if (!useLUT && !SEGENV.allocateData(heatSize)) return mode_static(); //allocation failed
+  const uint16_t lutSize = useLUT ? FIRE2012_LUT_SIZE * sizeof(CRGB) : 0;
+  CRGB* lut  = reinterpret_cast<CRGB*>(SEGENV.data);
+  byte* heat = SEGENV.data + lutSize;
+
+  // Step 4 (prepare). Map heat to color once per frame instead of once per pixel
+  if (useLUT) for (int i = 0; i < FIRE2012_LUT_SIZE; i++) lut[i] = ColorFromPalette(SEGPALETTE, i, 255, NOBLEND);
 
   const uint32_t it = strip.now >> 5; //div 32
 
   struct virtualStrip {
-    static void runStrip(uint16_t stripNr, byte* heat, uint32_t it) {
-
-      const uint8_t ignition = max(3,SEGLEN/10);  // ignition area: 10% of segment length or minimum 3 pixels
-
-      // Step 1.  Cool down every cell a little
-      for (int i = 0; i < SEGLEN; i++) {
-        uint8_t cool = (it != SEGENV.step) ? random8((((20 + SEGMENT.speed/3) * 16) / SEGLEN)+2) : random(4);
-        uint8_t minTemp = (i<ignition) ? (ignition-i)/4 + 16 : 0;  // should not become black in ignition area
-        uint8_t temp = qsub8(heat[i], cool);
-        heat[i] = temp<minTemp ? minTemp : temp;
-      }
-
-      if (it != SEGENV.step) {
-        // Step 2.  Heat from each cell drifts 'up' and diffuses a little
-        for (int k = SEGLEN -1; k > 1; k--) {
-          heat[k] = (heat[k - 1] + (heat[k - 2]<<1) ) / 3;  // heat[k-2] multiplied by 2
+    static void runStrip(uint16_t stripNr, byte* heat, uint32_t it, const CRGB* lut) {
+      const uint8_t flames = constrain(1 + (SEGMENT.custom1 >> 5), 1, MAX(SEGLEN/3, 1));
+      const uint16_t flameLen = SEGLEN / flames;
+      const uint16_t cooling = (((20 + SEGMENT.speed/3) * 16) / flameLen) + 2; // exceeds 255 for short flames
+      const uint8_t coolRange = (it != SEGENV.step) ? MIN(cooling, 255) : 4;
+
+      for (int f = 0; f < flames; f++) {
+        const uint16_t start = f * flameLen;
+        const uint16_t len   = (f == flames-1) ? SEGLEN - start : flameLen; // last flame takes the remainder
+        const uint8_t ignition = max(3, len/10);  // ignition area: 10% of flame length or minimum 3 pixels
+        byte* fh = &heat[start];
+
+        fire2012_cool(fh, len, coolRange, ignition);
+        if (it != SEGENV.step) {
+          fire2012_drift(fh, len);
+          fire2012_spark(fh, ignition);
         }
 
-        // Step 3.  Randomly ignite new 'sparks' of heat near the bottom
-        if (random8() <= SEGMENT.intensity) {
-          uint8_t y = random8(ignition);
-          uint8_t boost = (17+SEGMENT.custom3) * (ignition - y/2) / ignition; // integer math!
-          heat[y] = qadd8(heat[y], random8(96+2*boost,207+boost));
+        // Step 4.  Map from heat cells to LED colors
+        for (int j = 0; j < len; j++) {
+          uint16_t pix = start + ((f & 1) ? len - 1 - j : j);
+          uint8_t  h   = MIN(fh[j],240);
+          SEGMENT.setPixelColor(indexToVStrip(pix, stripNr), lut ? lut[h] : ColorFromPalette(SEGPALETTE, h, 255, NOBLEND));
         }
       }
-
-      // Step 4.  Map from heat cells to LED colors
-      for (int j = 0; j < SEGLEN; j++) {
-        SEGMENT.setPixelColor(indexToVStrip(j, stripNr), ColorFromPalette(SEGPALETTE, MIN(heat[j],240), 255, NOBLEND));
-      }
     }
   };
 
   for (int stripNr=0; stripNr<strips; stripNr++)
-    virtualStrip::runStrip(stripNr, &heat[stripNr * SEGLEN], it);
+    virtualStrip::runStrip(stripNr, &heat[stripNr * SEGLEN], it, useLUT ? lut : nullptr);
 
   if (SEGMENT.is2D()) SEGMENT.blur(32);
 
@@ -2024,7 +2063,7 @@ uint16_t mode_fire_2012() {
 
   return FRAMETIME;
 }
-static const char _data_FX_MODE_FIRE_2012[] PROGMEM = "Fire 2012@Cooling,Spark rate,,,Boost;;!;1;sx=64,ix=160,m12=1"; // bars
+static const char _data_FX_MODE_FIRE_2012[] PROGMEM = "Fire 2012@Cooling,Spark rate,Flames,,Boost;;!;1;sx=64,ix=160,c1=0,m12=1"; // bars
 
 
 // ColorWavesWithPalettes by Mark Kriegsman: https://gist.github.com/kriegsman/8281905786e8b2632aeb
@@ -2092,8 +2131,10 @@ static const char _data_FX_MODE_BPM[] PROGMEM = "Bpm@!;!;!;;sx=64";
 uint16_t mode_fillnoise8() {
   if (SEGENV.call == 0) SEGENV.step = random16(12345);
   //CRGB fastled_col;
+  NoiseParams np = {uint16_t(SEGLEN), 1, 0, uint16_t(SEGENV.step), 0, uint16_t(SEGLEN), uint16_t(SEGLEN), 0, 0, 1, 1, 2};
+  const uint8_t *field = strip.getNoiseField(np);
   for (int i = 0; i < SEGLEN; i++) {
-    uint8_t index = inoise8(i * SEGLEN, SEGENV.step + i * SEGLEN);
+    uint8_t index = field ? field[i] : inoise8(i * SEGLEN, SEGENV.step + i * SEGLEN);
     //fastled_col = ColorFromPalette(SEGPALETTE, index, 255, LINEARBLEND);
     //SEGMENT.setPixelColor(i, fastled_col.red, fastled_col.green, fastled_col.blue);
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
@@ -2775,12 +2816,144 @@ uint16_t mode_spots_fade()
 static const char _data_FX_MODE_SPOTS_FADE[] PROGMEM = "Spots Fade@Spread,Width,,,,,Overlay;!,!;!";
 
 
-//each needs 12 bytes
-typedef struct Ball {
-  unsigned long lastBounceTime;
-  float impactVelocity;
-  float height;
-} ball;
+/*
+ * Fixed-point particle system
+ * Shared by bouncing balls, popcorn, drip and exploding fireworks.
+ * Particle state is stored as a structure of arrays inside SEGENV.data so that bulk passes
+ * (integrate, collide, age, cull) only walk the arrays they need. Positions and velocities are Q16.16
+ * pixels, velocities and gravity are expressed per frame. A particle is alive while life != 0.
+ */
+#define PS_SHIFT     16
+#define PS_ONE       (1L << PS_SHIFT)
+#define PS_PIXEL(p)  int((p) >> PS_SHIFT) // fixed-point position to pixel (floor)
+
+// square root of Q16.16 value returning Q16.16 (used to get launch velocity for desired peak)
+static int32_t ps_sqrt(uint64_t x) {
+  uint64_t v = x << PS_SHIFT, res = 0, bit = 1ULL << 62;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= res + bit) {
+      v  -= res + bit;
+      res = (res >> 1) + bit;
+    } else res >>= 1;
+    bit >>= 2;
+  }
+  return res;
+}
+
+// narrow 64 bit intermediate physics results (large segments or long frame times) to a safe Q16.16 range
+static int32_t ps_clamp(int64_t x) {
+  return x > (1L << 30) ? (1L << 30) : x < -(1L << 30) ? -(1L << 30) : x;
+}
+
+typedef struct ParticleSystem {
+  uint16_t  count;
+  int32_t  *pos;      // position along strip (height on 2D)
+  int32_t  *vel;      // velocity along strip
+  int32_t  *posX;     // horizontal position (2D only)
+  int32_t  *velX;     // horizontal velocity (2D only)
+  uint16_t *life;     // remaining life (or brightness), 0 = inactive
+  uint8_t  *colIndex; // color (palette) index
+
+  // bytes used by one particle (11 on 1D, 19 on 2D)
+  static uint16_t particleSize(bool twoD = false) {
+    return (twoD ? 4 : 2) * sizeof(int32_t) + sizeof(uint16_t) + sizeof(uint8_t);
+  }
+  // bytes needed for n particles (padded so that consecutive systems stay aligned)
+  static uint16_t dataSize(uint16_t n, bool twoD = false) {
+    return (n * particleSize(twoD) + 3) & ~3;
+  }
+
+  // lay arrays out in (4 byte aligned) data, widest type first
+  void attach(byte *data, uint16_t n, bool twoD = false) {
+    count    = n;
+    pos      = reinterpret_cast<int32_t*>(data);
+    vel      = pos + n;
+    posX     = twoD ? vel  + n : nullptr;
+    velX     = twoD ? posX + n : nullptr;
+    life     = reinterpret_cast<uint16_t*>((twoD ? velX : vel) + n);
+    colIndex = reinterpret_cast<uint8_t*>(life + n);
+  }
+
+  // view of n particles starting at first (no copying)
+  ParticleSystem slice(uint16_t first, uint16_t n) const {
+    ParticleSystem s;
+    s.count    = n;
+    s.pos      = pos + first;
+    s.vel      = vel + first;
+    s.posX     = posX ? posX + first : nullptr;
+    s.velX     = velX ? velX + first : nullptr;
+    s.life     = life + first;
+    s.colIndex = colIndex + first;
+    return s;
+  }
+
+  // move active particles and accelerate them by gravity
+  void integrate(int32_t gravity, int32_t gravityX = 0) {
+    for (unsigned i = 0; i < count; i++) {
+      if (!life[i]) continue;
+      pos[i] += vel[i];
+      vel[i] += gravity;
+    }
+    if (!posX) return;
+    for (unsigned i = 0; i < count; i++) {
+      if (!life[i]) continue;
+      posX[i] += velX[i];
+      velX[i] += gravityX;
+    }
+  }
+
+  // bounce active particles off the floor: particles below it are put onto it and their velocity
+  // is reversed and scaled by damping[i] (Q8)
+  void collide(int32_t floor, const uint8_t *damping) {
+    for (unsigned i = 0; i < count; i++) {
+      if (!life[i] || pos[i] > floor) continue;
+      pos[i] = floor;
+      vel[i] = (-(int64_t)vel[i] * damping[i]) >> 8;
+    }
+  }
+
+  // exchange particles a and b (keeps particles in the same state contiguous for bulk passes)
+  void swap(uint16_t a, uint16_t b) {
+    if (a == b) return;
+    std::swap(pos[a], pos[b]);
+    std::swap(vel[a], vel[b]);
+    if (posX) std::swap(posX[a], posX[b]);
+    if (velX) std::swap(velX[a], velX[b]);
+    std::swap(life[a], life[b]);
+    std::swap(colIndex[a], colIndex[b]);
+  }
+
+  // reduce life of active particles by decay as long as it stays above floor
+  void age(uint16_t decay, uint16_t floor = 0) {
+    for (unsigned i = 0; i < count; i++) if (life[i] > floor) life[i] = (life[i] > decay) ? life[i] - decay : 0;
+  }
+
+  // deactivate particles whose position is outside [lo,hi)
+  void cull(int32_t lo, int32_t hi) {
+    for (unsigned i = 0; i < count; i++) if (pos[i] < lo || pos[i] >= hi) life[i] = 0;
+  }
+} particleSystem;
+
+// sub-pixel rendering of a particle on (virtual) strip, added to or blended over (additive = false) the background
+static void ps_render1D(int32_t pos, uint32_t color, int stripNr = -1, bool additive = true) {
+  int     p    = PS_PIXEL(pos);
+  uint8_t frac = (pos >> (PS_SHIFT - 8)) & 0xFF;
+  if (additive) {
+    if (p >= 0 && p < SEGLEN) SEGMENT.addPixelColor(indexToVStrip(p, stripNr), color_blend(BLACK, color, 255 - frac), true);
+    if (frac && p+1 >= 0 && p+1 < SEGLEN) SEGMENT.addPixelColor(indexToVStrip(p+1, stripNr), color_blend(BLACK, color, frac), true);
+  } else {
+    if (p >= 0 && p < SEGLEN) SEGMENT.blendPixelColor(indexToVStrip(p, stripNr), color, 255 - frac);
+    if (frac && p+1 >= 0 && p+1 < SEGLEN) SEGMENT.blendPixelColor(indexToVStrip(p+1, stripNr), color, frac);
+  }
+}
+
+// additive anti-aliased rendering of a particle on matrix (y is measured from top)
+static void ps_render2D(int32_t x, int32_t y, uint32_t color) {
+  if (x < 0 || y < 0) return;
+  SEGMENT.wu_pixel(x >> (PS_SHIFT - 8), y >> (PS_SHIFT - 8), CRGB(color));
+}
+
 
 /*
 *  Bouncing Balls Effect
@@ -2790,48 +2963,64 @@ uint16_t mode_bouncing_balls(void) {
   //allocate segment data
   const uint16_t strips = SEGMENT.nrOfVStrips(); // adapt for 2D
   const size_t maxNumBalls = 16;
-  uint16_t dataSize = sizeof(ball) * maxNumBalls;
+  uint16_t dataSize = ParticleSystem::dataSize(maxNumBalls);
   if (!SEGENV.allocateData(dataSize * strips)) return mode_static(); //allocation failed
 
-  Ball* balls = reinterpret_cast<Ball*>(SEGENV.data);
-
   if (!SEGMENT.check2) SEGMENT.fill(SEGCOLOR(2) ? BLACK : SEGCOLOR(1));
 
   // virtualStrip idea by @ewowi (Ewoud Wijma)
   // requires virtual strip # to be embedded into upper 16 bits of index in setPixelColor()
   // the following functions will not work on virtual strips: fill(), fade_out(), fadeToBlack(), blur()
+  // the physics advance by the time that actually passed in steps of one frame, as effect calls may be late
+  const uint32_t ft = FRAMETIME;
+  if (SEGENV.call == 0) SEGENV.step = strip.now - ft;
+  uint32_t steps = (strip.now - SEGENV.step) / ft;
+  if (steps > 8) { // do not catch up after a stall (or a time base change)
+    steps = 8;
+    SEGENV.step = strip.now - steps * ft;
+  }
+  SEGENV.step += steps * ft;
+
   struct virtualStrip {
-    static void runStrip(size_t stripNr, Ball* balls) {
+    static void runStrip(size_t stripNr, byte *data, uint32_t steps) {
+      ParticleSystem balls;
+      balls.attach(data, maxNumBalls);
       // number of balls based on intensity setting to max of 7 (cycles colors)
       // non-chosen color is a random color
       uint16_t numBalls = (SEGMENT.intensity * (maxNumBalls - 1)) / 255 + 1; // minimum 1 ball
-      const float gravity = -9.81f; // standard value of gravity
       const bool hasCol2 = SEGCOLOR(2);
-      const unsigned long time = millis();
+      // standard gravity (9.81 segment lengths/s^2) with time slowed down by speed, converted to pixels/frame^2
+      const int64_t timeScale = (255-SEGMENT.speed)/64 + 1;
+      const int64_t ft        = FRAMETIME;
+      const int64_t length    = SEGLEN - 1;
+      const int32_t gravity   = ps_clamp(-(643 * ft * ft / 1000) * length / (timeScale * timeScale));
+      const int32_t minVel    = ps_clamp(ft * length / timeScale);  // ~0.015 segment lengths/s
 
       if (SEGENV.call == 0) {
-        for (size_t i = 0; i < maxNumBalls; i++) balls[i].lastBounceTime = time;
+        for (size_t i = 0; i < maxNumBalls; i++) {
+          balls.pos[i]  = 0;
+          balls.vel[i]  = 0;
+          balls.life[i] = 1; // balls are always active
+        }
       }
 
-      for (size_t i = 0; i < numBalls; i++) {
-        float timeSinceLastBounce = (time - balls[i].lastBounceTime)/((255-SEGMENT.speed)/64 +1);
-        float timeSec = timeSinceLastBounce/1000.0f;
-        balls[i].height = (0.5f * gravity * timeSec + balls[i].impactVelocity) * timeSec; // avoid use pow(x, 2) - its extremely slow !
-
-        if (balls[i].height <= 0.0f) {
-          balls[i].height = 0.0f;
-          //damping for better effect using multiple balls
-          float dampening = 0.9f - float(i)/float(numBalls * numBalls); // avoid use pow(x, 2) - its extremely slow !
-          balls[i].impactVelocity = dampening * balls[i].impactVelocity;
-          balls[i].lastBounceTime = time;
-
-          if (balls[i].impactVelocity < 0.015f) {
-            float impactVelocityStart = sqrtf(-2.0f * gravity) * random8(5,11)/10.0f; // randomize impact velocity
-            balls[i].impactVelocity = impactVelocityStart;
+      //damping for better effect using multiple balls
+      uint8_t dampening[maxNumBalls];
+      for (size_t i = 0; i < numBalls; i++) dampening[i] = 230 - (256 * i) / (numBalls * numBalls); // 0.9 - i/n^2 (Q8)
+
+      balls.count = numBalls;
+      for (uint32_t s = 0; s < steps; s++) {
+        balls.integrate(gravity);
+        balls.collide(0, dampening);
+        for (size_t i = 0; i < numBalls; i++) {
+          if (balls.pos[i] == 0 && balls.vel[i] < minVel) {
+            balls.vel[i] = ps_clamp(29 * random8(5,11) * ft * length / timeScale); // randomize impact velocity (sqrt(2*9.81) * 0.5-1.0)
           }
-        } else if (balls[i].height > 1.0f) {
-          continue; // do not draw OOB ball
         }
+      }
+
+      for (size_t i = 0; i < numBalls; i++) {
+        if (balls.pos[i] > (length << PS_SHIFT)) continue; // do not draw OOB ball
 
         uint32_t color = SEGCOLOR(0);
         if (SEGMENT.palette) {
@@ -2840,15 +3029,15 @@ uint16_t mode_bouncing_balls(void) {
           color = SEGCOLOR(i % NUM_COLORS);
         }
 
-        int pos = roundf(balls[i].height * (SEGLEN - 1));
-        if (SEGLEN<32) SEGMENT.setPixelColor(indexToVStrip(pos, stripNr), color); // encode virtual strip into index
-        else           SEGMENT.setPixelColor(balls[i].height + (stripNr+1)*10.0f, color);
+        // balls replace the background (not added to it)
+        if (SEGLEN < 32) SEGMENT.setPixelColor(indexToVStrip(PS_PIXEL(balls.pos[i]), stripNr), color); // encode virtual strip into index
+        else             ps_render1D(balls.pos[i], color, stripNr, false);
       }
     }
   };
 
   for (int stripNr=0; stripNr<strips; stripNr++)
-    virtualStrip::runStrip(stripNr, &balls[stripNr * maxNumBalls]);
+    virtualStrip::runStrip(stripNr, SEGENV.data + stripNr * dataSize, steps);
 
   return FRAMETIME;
 }
@@ -2942,16 +3131,7 @@ uint16_t mode_solid_glitter()
 static const char _data_FX_MODE_SOLID_GLITTER[] PROGMEM = "Solid Glitter@,!;Bg,,Glitter color;;;m12=0";
 
 
-//each needs 19 bytes
-//Spark type is used for popcorn, 1D fireworks, and drip
-typedef struct Spark {
-  float pos, posX;
-  float vel, velX;
-  uint16_t col;
-  uint8_t colIndex;
-} spark;
-
-#define maxNumPopcorn 21 // max 21 on 16 segment ESP8266
+#define maxNumPopcorn 38 // max 38 on 16 segment ESP8266 (11 bytes per kernel)
 /*
 *  POPCORN
 *  modified from https://github.com/kitesurfer1404/WS2812FX/blob/master/src/custom/Popcorn.h
@@ -2960,56 +3140,54 @@ uint16_t mode_popcorn(void) {
   if (SEGLEN == 1) return mode_static();
   //allocate segment data
   uint16_t strips = SEGMENT.nrOfVStrips();
-  uint16_t dataSize = sizeof(spark) * maxNumPopcorn;
+  uint16_t dataSize = ParticleSystem::dataSize(maxNumPopcorn);
   if (!SEGENV.allocateData(dataSize * strips)) return mode_static(); //allocation failed
 
-  Spark* popcorn = reinterpret_cast<Spark*>(SEGENV.data);
-
   bool hasCol2 = SEGCOLOR(2);
   if (!SEGMENT.check2) SEGMENT.fill(hasCol2 ? BLACK : SEGCOLOR(1));
 
   struct virtualStrip {
-    static void runStrip(uint16_t stripNr, Spark* popcorn) {
-      float gravity = -0.0001 - (SEGMENT.speed/200000.0); // m/s/s
-      gravity *= SEGLEN;
+    static void runStrip(uint16_t stripNr, byte *data) {
+      ParticleSystem popcorn;
+      popcorn.attach(data, maxNumPopcorn);
+      int32_t gravity = -(int32_t)(((655 + 33*SEGMENT.speed) * SEGLEN) / 100); // (-0.0001 - speed/200000) * SEGLEN in Q16
 
       uint8_t numPopcorn = SEGMENT.intensity*maxNumPopcorn/255;
       if (numPopcorn == 0) numPopcorn = 1;
+      popcorn.count = numPopcorn;
+
+      popcorn.integrate(gravity);                // update position of active kernels
+      popcorn.cull(0, INT32_MAX);                // kernels that fell down become inactive
 
       for(int i = 0; i < numPopcorn; i++) {
-        if (popcorn[i].pos >= 0.0f) { // if kernel is active, update its position
-          popcorn[i].pos += popcorn[i].vel;
-          popcorn[i].vel += gravity;
-        } else { // if kernel is inactive, randomly pop it
-          if (random8() < 2) { // POP!!!
-            popcorn[i].pos = 0.01f;
-
-            uint16_t peakHeight = 128 + random8(128); //0-255
-            peakHeight = (peakHeight * (SEGLEN -1)) >> 8;
-            popcorn[i].vel = sqrtf(-2.0f * gravity * peakHeight);
-
-            if (SEGMENT.palette)
-            {
-              popcorn[i].colIndex = random8();
-            } else {
-              byte col = random8(0, NUM_COLORS);
-              if (!SEGCOLOR(2) || !SEGCOLOR(col)) col = 0;
-              popcorn[i].colIndex = col;
-            }
+        if (!popcorn.life[i] && random8() < 2) { // if kernel is inactive, randomly pop it
+          popcorn.pos[i]  = PS_ONE / 100;
+          popcorn.life[i] = 1;
+
+          uint16_t peakHeight = 128 + random8(128); //0-255
+          peakHeight = (peakHeight * (SEGLEN -1)) >> 8;
+          popcorn.vel[i] = ps_sqrt(-2LL * gravity * peakHeight);
+
+          if (SEGMENT.palette)
+          {
+            popcorn.colIndex[i] = random8();
+          } else {
+            byte col = random8(0, NUM_COLORS);
+            if (!SEGCOLOR(2) || !SEGCOLOR(col)) col = 0;
+            popcorn.colIndex[i] = col;
           }
         }
-        if (popcorn[i].pos >= 0.0f) { // draw now active popcorn (either active before or just popped)
-          uint32_t col = SEGMENT.color_wheel(popcorn[i].colIndex);
-          if (!SEGMENT.palette && popcorn[i].colIndex < NUM_COLORS) col = SEGCOLOR(popcorn[i].colIndex);
-          uint16_t ledIndex = popcorn[i].pos;
-          if (ledIndex < SEGLEN) SEGMENT.setPixelColor(indexToVStrip(ledIndex, stripNr), col);
+        if (popcorn.life[i]) { // draw now active popcorn (either active before or just popped)
+          uint32_t col = SEGMENT.color_wheel(popcorn.colIndex[i]);
+          if (!SEGMENT.palette && popcorn.colIndex[i] < NUM_COLORS) col = SEGCOLOR(popcorn.colIndex[i]);
+          ps_render1D(popcorn.pos[i], col, stripNr);
         }
       }
     }
   };
 
   for (int stripNr=0; stripNr<strips; stripNr++)
-    virtualStrip::runStrip(stripNr, &popcorn[stripNr * maxNumPopcorn]);
+    virtualStrip::runStrip(stripNr, SEGENV.data + stripNr * dataSize);
 
   return FRAMETIME;
 }
@@ -3116,18 +3294,16 @@ static const char _data_FX_MODE_CANDLE_MULTI[] PROGMEM = "Candle Multi@!,!;!,!;!
 / Speed sets frequency of new starbursts, intensity is the intensity of the burst
 */
 #ifdef ESP8266
-  #define STARBURST_MAX_FRAG   8 //52 bytes / star
+  #define STARBURST_MAX_FRAG   8 //48 bytes / star
 #else
-  #define STARBURST_MAX_FRAG  10 //60 bytes / star
+  #define STARBURST_MAX_FRAG  10 //56 bytes / star
 #endif
-//each needs 20+STARBURST_MAX_FRAG*4 bytes
+//each needs 16+STARBURST_MAX_FRAG*4 bytes (fragments are stored after all stars)
 typedef struct particle {
   CRGB     color;
   uint32_t birth  =0;
-  uint32_t last   =0;
-  float    vel    =0;
+  int32_t  vel    =0; // 1/256 pixel per second
   uint16_t pos    =-1;
-  float    fragment[STARBURST_MAX_FRAG];
 } star;
 
 uint16_t mode_starburst(void) {
@@ -3136,21 +3312,26 @@ uint16_t mode_starburst(void) {
   uint8_t segs = strip.getActiveSegmentsNum();
   if (segs <= (strip.getMaxSegments() /2)) maxData *= 2; //ESP8266: 512 if <= 8 segs ESP32: 1280 if <= 16 segs
   if (segs <= (strip.getMaxSegments() /4)) maxData *= 2; //ESP8266: 1024 if <= 4 segs ESP32: 2560 if <= 8 segs
-  uint16_t maxStars = maxData / sizeof(star); //ESP8266: max. 4/9/19 stars/seg, ESP32: max. 10/21/42 stars/seg
+  const uint16_t starSize = sizeof(star) + STARBURST_MAX_FRAG * sizeof(int32_t);
+  uint16_t maxStars = maxData / starSize; //ESP8266: max. 5/10/21 stars/seg, ESP32: max. 11/22/45 stars/seg
 
   uint8_t numStars = 1 + (SEGLEN >> 3);
   if (numStars > maxStars) numStars = maxStars;
-  uint16_t dataSize = sizeof(star) * numStars;
+  uint16_t dataSize = starSize * numStars;
 
   if (!SEGENV.allocateData(dataSize)) return mode_static(); //allocation failed
 
   uint32_t it = millis();
+  uint32_t dt = it - SEGENV.step; // time since last frame
+  if (dt > 100) dt = 100;         // limit movement after stalls (and keep fixed-point math in range)
+  SEGENV.step = it;
 
   star* stars = reinterpret_cast<star*>(SEGENV.data);
+  int32_t* fragments = reinterpret_cast<int32_t*>(SEGENV.data + sizeof(star) * numStars); // Q16.16 position, -1 if unused
 
-  float          maxSpeed                = 375.0f;  // Max velocity
-  float          particleIgnition        = 250.0f;  // How long to "flash"
-  float          particleFadeTime        = 1500.0f; // Fade out time
+  const uint32_t maxSpeed         = 375 << 8; // Max velocity
+  const uint32_t particleIgnition = 250;      // How long to "flash"
+  const uint32_t particleFadeTime = 1500;     // Fade out time
 
   for (int j = 0; j < numStars; j++)
   {
@@ -3159,19 +3340,19 @@ uint16_t mode_starburst(void) {
     {
       // Pick a random color and location.
       uint16_t startPos = random16(SEGLEN-1);
-      float multiplier = (float)(random8())/255.0 * 1.0;
+      uint8_t multiplier = random8();
 
       stars[j].color = CRGB(SEGMENT.color_wheel(random8()));
       stars[j].pos = startPos;
-      stars[j].vel = maxSpeed * (float)(random8())/255.0 * multiplier;
+      stars[j].vel = (maxSpeed * random8() / 255) * multiplier / 255;
       stars[j].birth = it;
-      stars[j].last = it;
       // more fragments means larger burst effect
       int num = random8(3,6 + (SEGMENT.intensity >> 5));
 
+      int32_t *fragment = &fragments[j * STARBURST_MAX_FRAG];
       for (int i=0; i < STARBURST_MAX_FRAG; i++) {
-        if (i < num) stars[j].fragment[i] = startPos;
-        else stars[j].fragment[i] = -1;
+        if (i < num) fragment[i] = startPos << PS_SHIFT;
+        else fragment[i] = -1;
       }
     }
   }
@@ -3180,55 +3361,52 @@ uint16_t mode_starburst(void) {
 
   for (int j=0; j<numStars; j++)
   {
-    if (stars[j].birth != 0) {
-      float dt = (it-stars[j].last)/1000.0;
-
+    int32_t *fragment = &fragments[j * STARBURST_MAX_FRAG];
+    if (stars[j].birth != 0 && stars[j].birth != it) {
       for (int i=0; i < STARBURST_MAX_FRAG; i++) {
         int var = i >> 1;
 
-        if (stars[j].fragment[i] > 0) {
+        if (fragment[i] > 0) {
           //all fragments travel right, will be mirrored on other side
-          stars[j].fragment[i] += stars[j].vel * dt * (float)var/3.0;
+          fragment[i] += stars[j].vel * (int32_t)dt * var * 32 / 375; // vel * dt/1000 * var/3 in Q16
         }
       }
-      stars[j].last = it;
-      stars[j].vel -= 3*stars[j].vel*dt;
+      stars[j].vel -= stars[j].vel * 3 * (int32_t)dt / 1000;
     }
 
     CRGB c = stars[j].color;
 
     // If the star is brand new, it flashes white briefly.
     // Otherwise it just fades over time.
-    float fade = 0.0f;
-    float age = it-stars[j].birth;
+    uint8_t fade = 0;
+    uint32_t age = it-stars[j].birth;
 
     if (age < particleIgnition) {
-      c = CRGB(color_blend(WHITE, RGBW32(c.r,c.g,c.b,0), 254.5f*((age / particleIgnition))));
+      c = CRGB(color_blend(WHITE, RGBW32(c.r,c.g,c.b,0), 254 * age / particleIgnition));
     } else {
       // Figure out how much to fade and shrink the star based on
       // its age relative to its lifetime
       if (age > particleIgnition + particleFadeTime) {
-        fade = 1.0f;                  // Black hole, all faded out
+        fade = 255;                   // Black hole, all faded out
         stars[j].birth = 0;
         c = CRGB(SEGCOLOR(1));
       } else {
         age -= particleIgnition;
-        fade = (age / particleFadeTime);  // Fading star
-        byte f = 254.5f*fade;
-        c = CRGB(color_blend(RGBW32(c.r,c.g,c.b,0), SEGCOLOR(1), f));
+        fade = 254 * age / particleFadeTime; // Fading star
+        c = CRGB(color_blend(RGBW32(c.r,c.g,c.b,0), SEGCOLOR(1), fade));
       }
     }
 
-    float particleSize = (1.0f - fade) * 2.0f;
+    int32_t particleSize = (255 - fade) * 2 * PS_ONE / 255;
 
     for (size_t index=0; index < STARBURST_MAX_FRAG*2; index++) {
       bool mirrored = index & 0x1;
       uint8_t i = index >> 1;
-      if (stars[j].fragment[i] > 0) {
-        float loc = stars[j].fragment[i];
-        if (mirrored) loc -= (loc-stars[j].pos)*2;
-        int start = loc - particleSize;
-        int end = loc + particleSize;
+      if (fragment[i] > 0) {
+        int32_t loc = fragment[i];
+        if (mirrored) loc -= (loc - ((int32_t)stars[j].pos << PS_SHIFT))*2;
+        int start = PS_PIXEL(loc - particleSize);
+        int end = PS_PIXEL(loc + particleSize);
         if (start < 0) start = 0;
         if (start == end) end++;
         if (end > SEGLEN) end = SEGLEN;
@@ -3252,58 +3430,62 @@ static const char _data_FX_MODE_STARBURST[] PROGMEM = "Fireworks Starburst@Chanc
 uint16_t mode_exploding_fireworks(void)
 {
   if (SEGLEN == 1) return mode_static();
-  const uint16_t cols = strip.isMatrix ? SEGMENT.virtualWidth() : 1;
-  const uint16_t rows = strip.isMatrix ? SEGMENT.virtualHeight() : SEGMENT.virtualLength();
+  const bool     twoD = strip.isMatrix;
+  const uint16_t cols = twoD ? SEGMENT.virtualWidth() : 1;
+  const uint16_t rows = twoD ? SEGMENT.virtualHeight() : SEGMENT.virtualLength();
 
   //allocate segment data
   uint16_t maxData = FAIR_DATA_PER_SEG; //ESP8266: 256 ESP32: 640
   uint8_t segs = strip.getActiveSegmentsNum();
   if (segs <= (strip.getMaxSegments() /2)) maxData *= 2; //ESP8266: 512 if <= 8 segs ESP32: 1280 if <= 16 segs
   if (segs <= (strip.getMaxSegments() /4)) maxData *= 2; //ESP8266: 1024 if <= 4 segs ESP32: 2560 if <= 8 segs
-  int maxSparks = maxData / sizeof(spark); //ESP8266: max. 21/42/85 sparks/seg, ESP32: max. 53/106/213 sparks/seg
+  int maxSparks = maxData / ParticleSystem::particleSize(twoD); //1D ESP8266: max. 23/46/93 sparks/seg, ESP32: max. 58/116/232 sparks/seg
 
   uint16_t numSparks = min(2 + ((rows*cols) >> 1), maxSparks);
-  uint16_t dataSize = sizeof(spark) * numSparks;
-  if (!SEGENV.allocateData(dataSize + sizeof(float))) return mode_static(); //allocation failed
-  float *dying_gravity = reinterpret_cast<float*>(SEGENV.data + dataSize);
+  uint16_t dataSize = ParticleSystem::dataSize(numSparks, twoD);
+  if (!SEGENV.allocateData(sizeof(int32_t) + dataSize)) return mode_static(); //allocation failed
+  int32_t *dying_gravity = reinterpret_cast<int32_t*>(SEGENV.data);
 
   if (dataSize != SEGENV.aux1) { //reset to flare if sparks were reallocated (it may be good idea to reset segment if bounds change)
-    *dying_gravity = 0.0f;
+    *dying_gravity = 0;
     SEGENV.aux0 = 0;
     SEGENV.aux1 = dataSize;
   }
 
   SEGMENT.fade_out(252);
 
-  Spark* sparks = reinterpret_cast<Spark*>(SEGENV.data);
-  Spark* flare = sparks; //first spark is flare data
+  ParticleSystem sparks;
+  sparks.attach(SEGENV.data + sizeof(int32_t), numSparks, twoD); //first spark is flare data
 
-  float gravity = -0.0004f - (SEGMENT.speed/800000.0f); // m/s/s
-  gravity *= rows;
+  int32_t gravity = -(int32_t)(((2621 + 8*SEGMENT.speed) * rows) / 100); // (-0.0004 - speed/800000) * rows in Q16
+  const int32_t top = (rows - 1) << PS_SHIFT;
 
   if (SEGENV.aux0 < 2) { //FLARE
     if (SEGENV.aux0 == 0) { //init flare
-      flare->pos = 0;
-      flare->posX = strip.isMatrix ? random16(2,cols-3) : (SEGMENT.intensity > random8()); // will enable random firing side on 1D
+      sparks.pos[0] = 0;
+      if (twoD) {
+        sparks.posX[0] = random16(2,cols-3) << PS_SHIFT;
+        sparks.velX[0] = ((int32_t)random8(9) - 4) * PS_ONE / 32;
+      } else {
+        SEGENV.step = (SEGMENT.intensity > random8()); // will enable random firing side on 1D
+      }
       uint16_t peakHeight = 75 + random8(180); //0-255
       peakHeight = (peakHeight * (rows -1)) >> 8;
-      flare->vel = sqrtf(-2.0f * gravity * peakHeight);
-      flare->velX = strip.isMatrix ? (random8(9)-4)/32.f : 0; // no X velocity on 1D
-      flare->col = 255; //brightness
+      sparks.vel[0]  = ps_sqrt(-2LL * gravity * peakHeight);
+      sparks.life[0] = 255; //brightness
       SEGENV.aux0 = 1;
     }
 
     // launch
-    if (flare->vel > 12 * gravity) {
+    if (sparks.vel[0] > 12 * gravity) {
       // flare
-      if (strip.isMatrix) SEGMENT.setPixelColorXY(int(flare->posX), rows - uint16_t(flare->pos) - 1, flare->col, flare->col, flare->col);
-      else                SEGMENT.setPixelColor(int(flare->posX) ? rows - int(flare->pos) - 1 : int(flare->pos), flare->col, flare->col, flare->col);
-      flare->pos  += flare->vel;
-      flare->posX += flare->velX;
-      flare->pos  = constrain(flare->pos, 0, rows-1);
-      flare->posX = constrain(flare->posX, 0, cols-strip.isMatrix);
-      flare->vel  += gravity;
-      flare->col  -= 2;
+      uint8_t b = sparks.life[0];
+      if (twoD) SEGMENT.setPixelColorXY(PS_PIXEL(sparks.posX[0]), rows - PS_PIXEL(sparks.pos[0]) - 1, b, b, b);
+      else      SEGMENT.setPixelColor(SEGENV.step ? rows - PS_PIXEL(sparks.pos[0]) - 1 : PS_PIXEL(sparks.pos[0]), b, b, b);
+      sparks.pos[0] = constrain(sparks.pos[0] + sparks.vel[0], 0, top);
+      if (twoD) sparks.posX[0] = constrain(sparks.posX[0] + sparks.velX[0], 0, (int32_t)(cols - 1) << PS_SHIFT);
+      sparks.vel[0]  += gravity;
+      sparks.life[0] -= 2;
     } else {
       SEGENV.aux0 = 2;  // ready to explode
     }
@@ -3314,41 +3496,39 @@ uint16_t mode_exploding_fireworks(void)
      * Explosion happens where the flare ended.
      * Size is proportional to the height.
      */
-    int nSparks = flare->pos + random8(4);
+    int nSparks = PS_PIXEL(sparks.pos[0]) + random8(4);
     nSparks = constrain(nSparks, 4, numSparks);
 
     // initialize sparks
     if (SEGENV.aux0 == 2) {
       for (int i = 1; i < nSparks; i++) {
-        sparks[i].pos  = flare->pos;
-        sparks[i].posX = flare->posX;
-        sparks[i].vel  = (float(random16(20001)) / 10000.0f) - 0.9f; // from -0.9 to 1.1
-        sparks[i].vel *= rows<32 ? 0.5f : 1; // reduce velocity for smaller strips
-        sparks[i].velX = strip.isMatrix ? (float(random16(10001)) / 10000.0f) - 0.5f : 0; // from -0.5 to 0.5
-        sparks[i].col  = 345;//abs(sparks[i].vel * 750.0); // set colors before scaling velocity to keep them bright
-        //sparks[i].col = constrain(sparks[i].col, 0, 345);
-        sparks[i].colIndex = random8();
-        sparks[i].vel  *= flare->pos/rows; // proportional to height
-        sparks[i].velX *= strip.isMatrix ? flare->posX/cols : 0; // proportional to width
-        sparks[i].vel  *= -gravity *50;
+        sparks.pos[i] = sparks.pos[0];
+        int32_t vel = (int32_t)random16(20001) * PS_ONE / 10000 - PS_ONE * 9 / 10; // from -0.9 to 1.1
+        if (rows < 32) vel /= 2; // reduce velocity for smaller strips
+        vel = (int64_t)vel * sparks.pos[0] / ((int32_t)rows << PS_SHIFT); // proportional to height
+        sparks.vel[i] = ((int64_t)vel * -gravity * 50) >> PS_SHIFT;
+        if (twoD) {
+          int32_t velX = (int32_t)random16(10001) * PS_ONE / 10000 - PS_ONE / 2; // from -0.5 to 0.5
+          sparks.posX[i] = sparks.posX[0];
+          sparks.velX[i] = (int64_t)velX * sparks.posX[0] / ((int32_t)cols << PS_SHIFT); // proportional to width
+        }
+        sparks.life[i]     = 345; // set colors before scaling velocity to keep them bright
+        sparks.colIndex[i] = random8();
       }
-      //sparks[1].col = 345; // this will be our known spark
       *dying_gravity = gravity/2;
       SEGENV.aux0 = 3;
     }
 
-    if (sparks[1].col > 4) {//&& sparks[1].pos > 0) { // as long as our known spark is lit, work with all the sparks
-      for (int i = 1; i < nSparks; i++) {
-        sparks[i].pos  += sparks[i].vel;
-        sparks[i].posX += sparks[i].velX;
-        sparks[i].vel  += *dying_gravity;
-        sparks[i].velX += strip.isMatrix ? *dying_gravity : 0;
-        if (sparks[i].col > 3) sparks[i].col -= 4;
-
-        if (sparks[i].pos > 0 && sparks[i].pos < rows) {
-          if (strip.isMatrix && !(sparks[i].posX >= 0 && sparks[i].posX < cols)) continue;
-          uint16_t prog = sparks[i].col;
-          uint32_t spColor = (SEGMENT.palette) ? SEGMENT.color_wheel(sparks[i].colIndex) : SEGCOLOR(0);
+    if (sparks.life[1] > 4) { // as long as our known spark is lit, work with all the sparks
+      ParticleSystem burst = sparks.slice(1, nSparks - 1);
+      burst.integrate(*dying_gravity, twoD ? *dying_gravity : 0);
+      burst.age(4, 3);
+
+      for (int i = 0; i < burst.count; i++) {
+        if (burst.pos[i] > 0 && burst.pos[i] < ((int32_t)rows << PS_SHIFT)) {
+          if (twoD && !(burst.posX[i] >= 0 && burst.posX[i] < ((int32_t)cols << PS_SHIFT))) continue;
+          uint16_t prog = burst.life[i];
+          uint32_t spColor = (SEGMENT.palette) ? SEGMENT.color_wheel(burst.colIndex[i]) : SEGCOLOR(0);
           CRGB c = CRGB::Black; //HeatColor(sparks[i].col);
           if (prog > 300) { //fade from white to spark color
             c = CRGB(color_blend(spColor, WHITE, (prog - 300)*5));
@@ -3358,12 +3538,12 @@ uint16_t mode_exploding_fireworks(void)
             c.g = qsub8(c.g, cooling);
             c.b = qsub8(c.b, cooling * 2);
           }
-          if (strip.isMatrix) SEGMENT.setPixelColorXY(int(sparks[i].posX), rows - int(sparks[i].pos) - 1, c.red, c.green, c.blue);
-          else                SEGMENT.setPixelColor(int(sparks[i].posX) ? rows - int(sparks[i].pos) - 1 : int(sparks[i].pos), c.red, c.green, c.blue);
+          if (twoD) ps_render2D(burst.posX[i], top - burst.pos[i], RGBW32(c.r,c.g,c.b,0));
+          else      ps_render1D(SEGENV.step ? top - burst.pos[i] : burst.pos[i], RGBW32(c.r,c.g,c.b,0));
         }
       }
       SEGMENT.blur(16);
-      *dying_gravity *= .8f; // as sparks burn out they fall slower
+      *dying_gravity = (*dying_gravity * 4) / 5; // as sparks burn out they fall slower
     } else {
       SEGENV.aux0 = 6 + random8(10); //wait for this many frames
     }
@@ -3376,7 +3556,6 @@ uint16_t mode_exploding_fireworks(void)
 
   return FRAMETIME;
 }
-#undef MAX_SPARKS
 static const char _data_FX_MODE_EXPLODING_FIREWORKS[] PROGMEM = "Fireworks 1D@Gravity,Firing side;!,!;!;12;pal=11,ix=128";
 
 
@@ -3390,68 +3569,73 @@ uint16_t mode_drip(void)
   //allocate segment data
   uint16_t strips = SEGMENT.nrOfVStrips();
   const int maxNumDrops = 4;
-  uint16_t dataSize = sizeof(spark) * maxNumDrops;
+  uint16_t dataSize = ParticleSystem::dataSize(maxNumDrops);
   if (!SEGENV.allocateData(dataSize * strips)) return mode_static(); //allocation failed
-  Spark* drops = reinterpret_cast<Spark*>(SEGENV.data);
 
   if (!SEGMENT.check2) SEGMENT.fill(SEGCOLOR(1));
 
   struct virtualStrip {
-    static void runStrip(uint16_t stripNr, Spark* drops) {
+    static void runStrip(uint16_t stripNr, byte *data) {
+      // drop state (0 init, 1 forming, 2 falling, 5 bouncing) is kept in colIndex, brightness in life
+      ParticleSystem drops;
+      drops.attach(data, maxNumDrops);
 
       uint8_t numDrops = 1 + (SEGMENT.intensity >> 6); // 255>>6 = 3
 
-      float gravity = -0.0005 - (SEGMENT.speed/50000.0);
-      gravity *= SEGLEN-1;
+      int32_t gravity = -(int32_t)(((3277 + 131*SEGMENT.speed) * (SEGLEN-1)) / 100); // (-0.0005 - speed/50000) * (SEGLEN-1) in Q16
       int sourcedrop = 12;
 
+      // drops that are falling (or bouncing) are kept at the front so they move in a single integrate pass
+      // gravity is negative, forming drops and drops that already hit the bottom must not move
+      uint8_t falling = 0;
+      for (int j=0;j<numDrops;j++) if (drops.colIndex[j] > 1 && drops.pos[j] > 0) drops.swap(j, falling++);
+      drops.slice(0, falling).integrate(gravity);
+      for (int j=0;j<falling;j++) if (drops.pos[j] < 0) drops.pos[j] = 0;
+
       for (int j=0;j<numDrops;j++) {
-        if (drops[j].colIndex == 0) { //init
-          drops[j].pos = SEGLEN-1;    // start at end
-          drops[j].vel = 0;           // speed
-          drops[j].col = sourcedrop;  // brightness
-          drops[j].colIndex = 1;      // drop state (0 init, 1 forming, 2 falling, 5 bouncing)
+        if (drops.colIndex[j] == 0) { //init
+          drops.pos[j] = (SEGLEN-1) << PS_SHIFT; // start at end
+          drops.vel[j] = 0;                      // speed
+          drops.life[j] = sourcedrop;            // brightness
+          drops.colIndex[j] = 1;                 // drop state (0 init, 1 forming, 2 falling, 5 bouncing)
         }
 
         SEGMENT.setPixelColor(indexToVStrip(SEGLEN-1, stripNr), color_blend(BLACK,SEGCOLOR(0), sourcedrop));// water source
-        if (drops[j].colIndex==1) {
-          if (drops[j].col>255) drops[j].col=255;
-          SEGMENT.setPixelColor(indexToVStrip(uint16_t(drops[j].pos), stripNr), color_blend(BLACK,SEGCOLOR(0),drops[j].col));
+        if (drops.colIndex[j]==1) {
+          if (drops.life[j]>255) drops.life[j]=255;
+          SEGMENT.setPixelColor(indexToVStrip(PS_PIXEL(drops.pos[j]), stripNr), color_blend(BLACK,SEGCOLOR(0),drops.life[j]));
 
-          drops[j].col += map(SEGMENT.speed, 0, 255, 1, 6); // swelling
+          drops.life[j] += map(SEGMENT.speed, 0, 255, 1, 6); // swelling
 
-          if (random8() < drops[j].col/10) {               // random drop
-            drops[j].colIndex=2;               //fall
-            drops[j].col=255;
+          if (random8() < drops.life[j]/10) {               // random drop
+            drops.colIndex[j]=2;               //fall
+            drops.life[j]=255;
+            drops.vel[j]=gravity;              // first integrate step, the drop moves from the next frame on
           }
         }
-        if (drops[j].colIndex > 1) {           // falling
-          if (drops[j].pos > 0) {              // fall until end of segment
-            drops[j].pos += drops[j].vel;
-            if (drops[j].pos < 0) drops[j].pos = 0;
-            drops[j].vel += gravity;           // gravity is negative
-
-            for (int i=1;i<7-drops[j].colIndex;i++) { // some minor math so we don't expand bouncing droplets
-              uint16_t pos = constrain(uint16_t(drops[j].pos) +i, 0, SEGLEN-1); //this is BAD, returns a pos >= SEGLEN occasionally
-              SEGMENT.setPixelColor(indexToVStrip(pos, stripNr), color_blend(BLACK,SEGCOLOR(0),drops[j].col/i)); //spread pixel with fade while falling
+        if (drops.colIndex[j] > 1) {           // falling
+          if (j < falling || drops.pos[j] > 0) { // fall until end of segment (moved above)
+            for (int i=1;i<7-drops.colIndex[j];i++) { // some minor math so we don't expand bouncing droplets
+              uint16_t pos = constrain(PS_PIXEL(drops.pos[j]) +i, 0, SEGLEN-1);
+              SEGMENT.setPixelColor(indexToVStrip(pos, stripNr), color_blend(BLACK,SEGCOLOR(0),drops.life[j]/i)); //spread pixel with fade while falling
             }
 
-            if (drops[j].colIndex > 2) {       // during bounce, some water is on the floor
-              SEGMENT.setPixelColor(indexToVStrip(0, stripNr), color_blend(SEGCOLOR(0),BLACK,drops[j].col));
+            if (drops.colIndex[j] > 2) {       // during bounce, some water is on the floor
+              SEGMENT.setPixelColor(indexToVStrip(0, stripNr), color_blend(SEGCOLOR(0),BLACK,drops.life[j]));
             }
           } else {                             // we hit bottom
-            if (drops[j].colIndex > 2) {       // already hit once, so back to forming
-              drops[j].colIndex = 0;
-              drops[j].col = sourcedrop;
+            if (drops.colIndex[j] > 2) {       // already hit once, so back to forming
+              drops.colIndex[j] = 0;
+              drops.life[j] = sourcedrop;
 
             } else {
 
-              if (drops[j].colIndex==2) {      // init bounce
-                drops[j].vel = -drops[j].vel/4;// reverse velocity with damping
-                drops[j].pos += drops[j].vel;
+              if (drops.colIndex[j]==2) {      // init bounce
+                drops.vel[j] = -drops.vel[j]/4;// reverse velocity with damping
+                drops.pos[j] += drops.vel[j];
               }
-              drops[j].col = sourcedrop*2;
-              drops[j].colIndex = 5;           // bouncing
+              drops.life[j] = sourcedrop*2;
+              drops.colIndex[j] = 5;           // bouncing
             }
           }
         }
@@ -3460,7 +3644,7 @@ uint16_t mode_drip(void)
   };
 
   for (int stripNr=0; stripNr<strips; stripNr++)
-    virtualStrip::runStrip(stripNr, &drops[stripNr*maxNumDrops]);
+    virtualStrip::runStrip(stripNr, SEGENV.data + stripNr * dataSize);
 
   return FRAMETIME;
 }
@@ -3923,8 +4107,10 @@ uint16_t mode_noisepal(void) {                                    // Slow noise
 
   if (SEGMENT.palette > 0) palettes[0] = SEGPALETTE;
 
+  NoiseParams np = {uint16_t(SEGLEN), 1, 0, SEGENV.aux0, 0, scale, scale, 0, 0, 1, 1, 2};
+  const uint8_t *field = strip.getNoiseField(np);
   for (int i = 0; i < SEGLEN; i++) {
-    uint8_t index = inoise8(i*scale, SEGENV.aux0+i*scale);                // Get a value from the noise function. I'm using both x and y axis.
+    uint8_t index = field ? field[i] : inoise8(i*scale, SEGENV.aux0+i*scale); // Get a value from the noise function. I'm using both x and y axis.
     color = ColorFromPalette(palettes[0], index, 255, LINEARBLEND);       // Use the my own palette.
     SEGMENT.setPixelColor(i, color.red, color.green, color.blue);
   }
@@ -4837,24 +5023,57 @@ static const char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y f
 ///////////////////////////////////////////
 //   2D Cellular Automata Game of life   //
 ///////////////////////////////////////////
-typedef struct ColorCount {
-  CRGB color;
-  int8_t count;
-} colorCount;
+// Cell state is kept as a bit-packed grid (one bit per cell, 32 cells per word, rows padded to
+// whole words). Neighbors are counted for 32 cells at once using bit-sliced adders; colors live
+// in the segment's leds[] buffer and are only touched for cells that are born or die.
+#define GOL_HASHES 16 // number of previous generations remembered for cycle detection
+
+// add one neighbor mask to bit-sliced counter s2:s1:s0 (s2 saturates meaning 4 or more)
+static inline void gol_count(uint32_t &s0, uint32_t &s1, uint32_t &s2, uint32_t n) {
+  uint32_t c = s0 & n;
+  s0 ^= n;
+  s2 |= s1 & c;
+  s1 ^= c;
+}
+
+// state of cells x-1 for word w of a row (wraps around left edge)
+static inline uint32_t gol_left(const uint32_t *row, int w, int cols) {
+  uint32_t prev = w ? row[w-1] >> 31 : (row[(cols-1) >> 5] >> ((cols-1) & 31)) & 1;
+  return (row[w] << 1) | prev;
+}
+
+// state of cells x+1 for word w of a row (wraps around right edge)
+static inline uint32_t gol_right(const uint32_t *row, int w, int wpr, int cols) {
+  uint32_t next = row[w] >> 1;
+  if (w < wpr-1) next |= row[w+1] << 31;
+  else           next |= (row[0] & 1) << ((cols-1) & 31);
+  return next;
+}
+
+static inline bool gol_cell(const uint32_t *grid, int wpr, int cols, int rows, int x, int y) {
+  x = (x + cols) % cols;
+  y = (y + rows) % rows;
+  return (grid[y*wpr + (x >> 5)] >> (x & 31)) & 1;
+}
 
 uint16_t mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://natureofcode.com/book/chapter-7-cellular-automata/ and https://github.com/DougHaber/nlife-color
   if (!strip.isMatrix) return mode_static(); // not a 2D set-up
 
   const uint16_t cols = SEGMENT.virtualWidth();
   const uint16_t rows = SEGMENT.virtualHeight();
-  const uint16_t dataSize = sizeof(CRGB) * SEGMENT.length();  // using width*height prevents reallocation if mirroring is enabled
-  const uint16_t crcBufferLen = 2; //(SEGMENT.width() + SEGMENT.height())*71/100; // roughly sqrt(2)/2 for better repetition detection (Ewowi)
+  const uint16_t wpr  = (cols + 31) >> 5; // words per row
+  // sized for either orientation of the physical segment, so mirroring or transposing neither
+  // reallocates nor overflows the grid
+  const uint16_t pw = SEGMENT.width(), ph = SEGMENT.height();
+  const size_t gridSize = MAX(((pw + 31) >> 5) * ph, ((ph + 31) >> 5) * pw) * sizeof(uint32_t);
 
-  if (!SEGENV.allocateData(dataSize + sizeof(uint16_t)*crcBufferLen)) return mode_static(); //allocation failed
-  CRGB *prevLeds = reinterpret_cast<CRGB*>(SEGENV.data);
-  uint16_t *crcBuffer = reinterpret_cast<uint16_t*>(SEGENV.data + dataSize); 
+  if (!SEGENV.allocateData(sizeof(uint32_t)*GOL_HASHES + 2*gridSize)) return mode_static(); //allocation failed
+  uint32_t *hashes = reinterpret_cast<uint32_t*>(SEGENV.data);
+  uint32_t *cur    = reinterpret_cast<uint32_t*>(SEGENV.data + sizeof(uint32_t)*GOL_HASHES + (SEGENV.aux1 ? gridSize : 0));
+  uint32_t *next   = reinterpret_cast<uint32_t*>(SEGENV.data + sizeof(uint32_t)*GOL_HASHES + (SEGENV.aux1 ? 0 : gridSize));
 
-  CRGB backgroundColor = SEGCOLOR(1);
+  const uint32_t bgc = SEGCOLOR(1) & 0x00FFFFFF; // no white channel (leds[] is RGB)
+  const uint32_t lastMask = (cols & 31) ? (1UL << (cols & 31)) - 1 : 0xFFFFFFFFUL; // valid cells in last word of a row
 
   if (SEGENV.call == 0) SEGMENT.setUpLeds();
 
@@ -4864,83 +5083,89 @@ uint16_t mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https:
     random16_set_seed(millis()>>2); //seed the random generator
 
     //give the leds random state and colors (based on intensity, colors from palette or all posible colors are chosen)
-    for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) {
-      uint8_t state = random8()%2;
-      if (state == 0)
-        SEGMENT.setPixelColorXY(x,y, backgroundColor);
-      else
-        SEGMENT.setPixelColorXY(x,y, SEGMENT.color_from_palette(random8(), false, PALETTE_SOLID_WRAP, 255));
+    for (int y = 0; y < rows; y++) for (int w = 0; w < wpr; w++) {
+      uint32_t bits = ((uint32_t)random16() << 16) | random16();
+      if (w == wpr-1) bits &= lastMask;
+      cur[y*wpr + w] = bits;
+      for (int b = 0; b < 32 && (w<<5) + b < cols; b++) {
+        if ((bits >> b) & 1) SEGMENT.setPixelColorXY((w<<5) + b, y, SEGMENT.color_from_palette(random8(), false, PALETTE_SOLID_WRAP, 255));
+        else                 SEGMENT.setPixelColorXY((w<<5) + b, y, bgc);
+      }
     }
-
-    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) prevLeds[XY(x,y)] = CRGB::Black;
-    memset(crcBuffer, 0, sizeof(uint16_t)*crcBufferLen);
+    memset(hashes, 0, sizeof(uint32_t)*GOL_HASHES);
   } else if (strip.now - SEGENV.step < FRAMETIME_FIXED * (uint32_t)map(SEGMENT.speed,0,255,64,4)) {
     // update only when appropriate time passes (in 42 FPS slots)
     return FRAMETIME;
   }
 
-  //copy previous leds (save previous generation)
-  //NOTE: using lossy getPixelColor() is a benefit as endlessly repeating patterns will eventually fade out causing a reset
-  for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) prevLeds[XY(x,y)] = SEGMENT.getPixelColorXY(x,y);
-
-  //calculate new leds
-  for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) {
-
-    colorCount colorsCount[9]; // count the different colors in the 3*3 matrix
-    for (int i=0; i<9; i++) colorsCount[i] = {backgroundColor, 0}; // init colorsCount
-
-    // iterate through neighbors and count them and their different colors
-    int neighbors = 0;
-    for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) { // iterate through 3*3 matrix
-      if (i==0 && j==0) continue; // ignore itself
-      // wrap around segment
-      int16_t xx = x+i, yy = y+j;
-      if (x+i < 0) xx = cols-1; else if (x+i >= cols) xx = 0;
-      if (y+j < 0) yy = rows-1; else if (y+j >= rows) yy = 0;
-
-      uint16_t xy = XY(xx, yy); // previous cell xy to check
-      // count different neighbours and colors
-      if (prevLeds[xy] != backgroundColor) {
-        neighbors++;
-        bool colorFound = false;
-        int k;
-        for (k=0; k<9 && colorsCount[i].count != 0; k++)
-          if (colorsCount[k].color == prevLeds[xy]) {
-            colorsCount[k].count++;
-            colorFound = true;
-          }
-        if (!colorFound) colorsCount[k] = {prevLeds[xy], 1}; //add new color found in the array
+  // calculate next generation; births only write cells that were dead so colors of live neighbors stay intact
+  uint32_t hash = 2166136261UL; // FNV-1a over generation words
+  for (int y = 0; y < rows; y++) {
+    const uint32_t *up = &cur[((y + rows - 1) % rows) * wpr];
+    const uint32_t *mid = &cur[y * wpr];
+    const uint32_t *dn = &cur[((y + 1) % rows) * wpr];
+    for (int w = 0; w < wpr; w++) {
+      uint32_t s0 = 0, s1 = 0, s2 = 0;
+      gol_count(s0, s1, s2, gol_left(up, w, cols));
+      gol_count(s0, s1, s2, up[w]);
+      gol_count(s0, s1, s2, gol_right(up, w, wpr, cols));
+      gol_count(s0, s1, s2, gol_left(mid, w, cols));
+      gol_count(s0, s1, s2, gol_right(mid, w, wpr, cols));
+      gol_count(s0, s1, s2, gol_left(dn, w, cols));
+      gol_count(s0, s1, s2, dn[w]);
+      gol_count(s0, s1, s2, gol_right(dn, w, wpr, cols));
+
+      const uint32_t mask  = (w == wpr-1) ? lastMask : 0xFFFFFFFFUL;
+      const uint32_t alive = mid[w];
+      uint32_t nextWord = alive & ~s2 & s1;              // survival: 2 or 3 neighbors
+      uint32_t born     = ~alive & ~s2 & s1 & s0 & mask; // reproduction: 3 neighbors
+      uint32_t mutate   = ~alive & ~s2 & s1 & ~s0 & mask; // mutation candidates: 2 neighbors
+
+      while (born) {
+        int b = __builtin_ctz(born);
+        born &= born - 1;
+        if (!random8(128)) continue; // a bit of randomness to avoid "gliders"
+        int x = (w<<5) + b;
+        // find dominant color of the 3 live neighbors (first found wins a tie)
+        uint32_t c[3] = {bgc, bgc, bgc};
+        int n = 0;
+        for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) {
+          if ((i || j) && n < 3 && gol_cell(cur, wpr, cols, rows, x+i, y+j)) c[n++] = SEGMENT.getPixelColorXY((x+i+cols)%cols, (y+j+rows)%rows);
+        }
+        SEGMENT.setPixelColorXY(x, y, (c[1] == c[2] && c[0] != c[1]) ? c[1] : c[0]);
+        nextWord |= 1UL << b;
       }
-    } // i,j
-
-    // Rules of Life
-    uint32_t col = prevLeds[XY(x,y)];
-    uint32_t bgc = RGBW32(backgroundColor.r, backgroundColor.g, backgroundColor.b, 0);
-    if      ((col != bgc) && (neighbors <  2)) SEGMENT.setPixelColorXY(x,y, bgc); // Loneliness
-    else if ((col != bgc) && (neighbors >  3)) SEGMENT.setPixelColorXY(x,y, bgc); // Overpopulation
-    else if ((col == bgc) && (neighbors == 3)) {                                  // Reproduction
-      // find dominant color and assign it to a cell
-      colorCount dominantColorCount = {backgroundColor, 0};
-      for (int i=0; i<9 && colorsCount[i].count != 0; i++)
-        if (colorsCount[i].count > dominantColorCount.count) dominantColorCount = colorsCount[i];
-      // assign the dominant color w/ a bit of randomness to avoid "gliders"
-      if (dominantColorCount.count > 0 && random8(128)) SEGMENT.setPixelColorXY(x,y, dominantColorCount.color);
-    } else if ((col == bgc) && (neighbors == 2) && !random8(128)) {               // Mutation
-      SEGMENT.setPixelColorXY(x,y, SEGMENT.color_from_palette(random8(), false, PALETTE_SOLID_WRAP, 255));
-    }
-    // else do nothing!
-  } //x,y
-
-  // calculate CRC16 of leds
-  uint16_t crc = crc16((const unsigned char*)prevLeds, dataSize);
-  // check if we had same CRC and reset if needed
+      while (mutate) {
+        int b = __builtin_ctz(mutate);
+        mutate &= mutate - 1;
+        if (random8(128)) continue;
+        SEGMENT.setPixelColorXY((w<<5) + b, y, SEGMENT.color_from_palette(random8(), false, PALETTE_SOLID_WRAP, 255));
+        nextWord |= 1UL << b;
+      }
+
+      next[y*wpr + w] = nextWord;
+      hash = (hash ^ nextWord) * 16777619UL;
+    }
+  }
+
+  // clear cells that died (after all births so neighbor colors were available)
+  for (int y = 0; y < rows; y++) for (int w = 0; w < wpr; w++) {
+    uint32_t died = cur[y*wpr + w] & ~next[y*wpr + w];
+    while (died) {
+      int b = __builtin_ctz(died);
+      died &= died - 1;
+      SEGMENT.setPixelColorXY((w<<5) + b, y, bgc);
+    }
+  }
+  SEGENV.aux1 = !SEGENV.aux1; // next generation becomes current
+
+  // same hash as one of recent generations would mean image did not change or was repeating itself
   bool repetition = false;
-  for (int i=0; i<crcBufferLen && !repetition; i++) repetition = (crc == crcBuffer[i]); // (Ewowi)
-  // same CRC would mean image did not change or was repeating itself
+  for (int i=0; i<GOL_HASHES && !repetition; i++) repetition = (hash == hashes[i]);
   if (!repetition) SEGENV.step = strip.now; //if no repetition avoid reset
-  // remember CRCs across frames
-  crcBuffer[SEGENV.aux0] = crc;
-  ++SEGENV.aux0 %= crcBufferLen;
+  // remember hashes across generations
+  hashes[SEGENV.aux0] = hash;
+  ++SEGENV.aux0 %= GOL_HASHES;
 
   return FRAMETIME;
 } // mode_2Dgameoflife()
@@ -5041,6 +5266,47 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
   dx = (xmax - xmin) / (cols);     // Scale the delta x and y values to our matrix size.
   dy = (ymax - ymin) / (rows);
 
+#if WLED_FX_FIXED_MATH
+  // z is iterated in Q13 fixed point; |a|,|b| <= 4 is checked before squaring so all products fit into 32 bits
+  // pixel coordinates are stepped in Q16 to keep precision when zoomed in
+  #define JULIA_Q 13
+  const int32_t reQ   = reAl * (1<<JULIA_Q);
+  const int32_t imQ   = imAg * (1<<JULIA_Q);
+  const int32_t limQ  = 4 << JULIA_Q;
+  const uint32_t maxQ = (uint32_t)maxCalc << (2*JULIA_Q);
+  const int32_t dxQ   = dx * 65536.f;
+  const int32_t dyQ   = dy * 65536.f;
+
+  int32_t y = ymin * 65536.f;
+  for (int j = 0; j < rows; j++) {
+    int32_t x = xmin * 65536.f;
+    for (int i = 0; i < cols; i++) {
+      int32_t a = x >> (16-JULIA_Q);
+      int32_t b = y >> (16-JULIA_Q);
+      int iter = 0;
+
+      while (iter < maxIterations) {
+        if (abs(a) > limQ || abs(b) > limQ) break; // |z|^2 > 16 already
+        int32_t aa = a * a;
+        int32_t bb = b * b;
+        if ((uint32_t)aa + (uint32_t)bb > maxQ) break;
+        b = ((a * b) >> (JULIA_Q-1)) + imQ; // 2ab + im
+        a = ((aa - bb) >> JULIA_Q) + reQ;
+        iter++;
+      } // while
+
+      // We color each pixel based on how long it takes to get to infinity, or black if it never gets there.
+      if (iter == maxIterations) {
+        SEGMENT.setPixelColorXY(i, j, 0);
+      } else {
+        SEGMENT.setPixelColorXY(i, j, SEGMENT.color_from_palette(iter*255/maxIterations, false, PALETTE_SOLID_WRAP, 0));
+      }
+      x += dxQ;
+    }
+    y += dyQ;
+  }
+  #undef JULIA_Q
+#else
   // Start y
   float y = ymin;
   for (int j = 0; j < rows; j++) {
@@ -5078,6 +5344,7 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
     }
     y += dy;
   }
+#endif
 //  SEGMENT.blur(64);
 
   return FRAMETIME;
@@ -5223,12 +5490,12 @@ uint16_t mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have
       } else {
         SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
       }
-      // show the 3 points, too
-      SEGMENT.setPixelColorXY(x1, y1, WHITE);
-      SEGMENT.setPixelColorXY(x2, y2, WHITE);
-      SEGMENT.setPixelColorXY(x3, y3, WHITE);
     }
   }
+  // show the 3 points, too
+  SEGMENT.setPixelColorXY(x1, y1, WHITE);
+  SEGMENT.setPixelColorXY(x2, y2, WHITE);
+  SEGMENT.setPixelColorXY(x3, y3, WHITE);
 
   return FRAMETIME;
 } // mode_2Dmetaballs()
@@ -5245,10 +5512,15 @@ uint16_t mode_2Dnoise(void) {                  // By Andrew Tuline
   const uint16_t rows = SEGMENT.virtualHeight();
 
   const uint16_t scale  = SEGMENT.intensity+2;
+  const uint16_t z      = strip.now / (16 - SEGMENT.speed/16);
+
+  // smooth (low scale) fields are sampled on a coarser lattice and interpolated
+  NoiseParams np = {cols, rows, 0, 0, z, scale, 0, 0, scale, 1, uint8_t(scale < 32 ? 4 : scale < 96 ? 2 : 1), 3};
+  const uint8_t *field = strip.getNoiseField(np);
 
   for (int y = 0; y < rows; y++) {
     for (int x = 0; x < cols; x++) {
-      uint8_t pixelHue8 = inoise8(x * scale, y * scale, millis() / (16 - SEGMENT.speed/16));
+      uint8_t pixelHue8 = field ? *field++ : inoise8(x * scale, y * scale, z);
       SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, pixelHue8));
     }
   }
@@ -5274,7 +5546,7 @@ uint16_t mode_2DPlasmaball(void) {                   // By: Stepko https://edito
 
   SEGMENT.fadeToBlackBy(SEGMENT.custom1>>2);
 
-  float t = millis() / (33 - SEGMENT.speed/8);
+  uint16_t t = millis() / (33 - SEGMENT.speed/8); // noise coordinates are 16 bit
   for (int i = 0; i < cols; i++) {
     uint16_t thisVal = inoise8(i * 30, t, t);
     uint16_t thisMax = map(thisVal, 0, 255, 0, cols-1);
@@ -5321,7 +5593,7 @@ uint16_t mode_2DPolarLights(void) {        // By: Kostyantyn Matviyevskyy  https
     SEGENV.step = 0;
   }
 
-  float adjustHeight = (float)map(rows, 8, 32, 28, 12); // maybe use mapf() ???
+  int adjustHeight = map(rows, 8, 32, 28, 12); // maybe use mapf() ???
   uint16_t adjScale = map(cols, 8, 64, 310, 63);
 /*
   if (SEGENV.aux1 != SEGMENT.custom1/12) {   // Hacky palette rotation. We need that black.
@@ -5344,10 +5616,11 @@ uint16_t mode_2DPolarLights(void) {        // By: Kostyantyn Matviyevskyy  https
   for (int x = 0; x < cols; x++) {
     for (int y = 0; y < rows; y++) {
       SEGENV.step++;
+      uint8_t dim = MIN(255, (abs(rows - 2*y) * adjustHeight) >> 1); // |rows/2 - y| * adjustHeight in integer math
       SEGMENT.setPixelColorXY(x, y, ColorFromPalette(auroraPalette,
                                       qsub8(
                                         inoise8((SEGENV.step%2) + x * _scale, y * 16 + SEGENV.step % 16, SEGENV.step / _speed),
-                                        fabsf((float)rows / 2.0f - (float)y) * adjustHeight)));
+                                        dim)));
     }
   }
 
@@ -5721,8 +5994,14 @@ uint16_t mode_2Dghostrider(void) {
     CRGB color = CRGB::White;
     SEGMENT.wu_pixel(lighter->gPosX * 256 / 10, lighter->gPosY * 256 / 10, color);
 
+#if WLED_FX_FIXED_MATH
+    const uint16_t gA = (lighter->gAngle % 360) * 65536L / 360; // degrees to sin16() angle
+    lighter->gPosX += (lighter->Vspeed * (int32_t)sin16(gA)) / 32768;
+    lighter->gPosY += (lighter->Vspeed * (int32_t)cos16(gA)) / 32768;
+#else
     lighter->gPosX += lighter->Vspeed * sin_t(radians(lighter->gAngle));
     lighter->gPosY += lighter->Vspeed * cos_t(radians(lighter->gAngle));
+#endif
     lighter->gAngle += lighter->angleSpeed;
     if (lighter->gPosX < 0)               lighter->gPosX = (cols - 1) * 10;
     if (lighter->gPosX > (cols - 1) * 10) lighter->gPosX = 0;
@@ -5744,8 +6023,14 @@ uint16_t mode_2Dghostrider(void) {
         lighter->time[i] = 0;
         lighter->reg[i] = false;
       } else {
+#if WLED_FX_FIXED_MATH
+        const uint16_t a = (lighter->Angle[i] % 360) * 65536L / 360; // degrees to sin16() angle
+        lighter->lightersPosX[i] += (-7 * (int32_t)sin16(a)) >> 15;
+        lighter->lightersPosY[i] += (-7 * (int32_t)cos16(a)) >> 15;
+#else
         lighter->lightersPosX[i] += -7 * sin_t(radians(lighter->Angle[i]));
         lighter->lightersPosY[i] += -7 * cos_t(radians(lighter->Angle[i]));
+#endif
       }
       SEGMENT.wu_pixel(lighter->lightersPosX[i] * 256 / 10, lighter->lightersPosY[i] * 256 / 10, ColorFromPalette(SEGPALETTE, (256 - lighter->time[i])));
     }
@@ -5861,15 +6146,29 @@ static const char _data_FX_MODE_2DBLOBS[] PROGMEM = "Blobs@!,# blobs,Blur;!;!;2;
 ////////////////////////////
 //     2D Scrolling text  //
 ////////////////////////////
+// text is rasterized once into a glyph strip whenever it (or the font) changes,
+// date/time tokens are expanded at most once per second
+#define SCROLLTEXT_MAX_CHARS 32
+typedef struct TextCache {
+  time_t   expanded;    // localTime of last token expansion
+  uint16_t width;       // rasterized width in columns
+  uint8_t  font;        // font & format the strip was made with
+  char     text[SCROLLTEXT_MAX_CHARS+1];
+  uint16_t columns[SCROLLTEXT_MAX_CHARS*7]; // 1 bit per pixel, bit 0 is the top row
+} textCache;
+
 uint16_t mode_2Dscrollingtext(void) {
   if (!strip.isMatrix) return mode_static(); // not a 2D set-up
+  if (!SEGENV.allocateData(sizeof(TextCache))) return mode_static(); //allocation failed
+  TextCache *cache = reinterpret_cast<TextCache*>(SEGENV.data);
 
   const uint16_t cols = SEGMENT.virtualWidth();
   const uint16_t rows = SEGMENT.virtualHeight();
 
   int letterWidth;
   int letterHeight;
-  switch (map(SEGMENT.custom2, 0, 255, 1, 5)) {
+  const uint8_t fontSize = map(SEGMENT.custom2, 0, 255, 1, 5);
+  switch (fontSize) {
     default:
     case 1: letterWidth = 4; letterHeight =  6; break;
     case 2: letterWidth = 5; letterHeight =  8; break;
@@ -5878,37 +6177,48 @@ uint16_t mode_2Dscrollingtext(void) {
     case 5: letterWidth = 5; letterHeight = 12; break;
   }
   const bool zero = SEGMENT.check3;
+  const uint8_t fontKey = fontSize | (zero << 4);
   const int yoffset = map(SEGMENT.intensity, 0, 255, -rows/2, rows/2) + (rows-letterHeight)/2;
-  char text[33] = {'\0'};
-  if (SEGMENT.name) for (size_t i=0,j=0; i<strlen(SEGMENT.name); i++) if (SEGMENT.name[i]>31 && SEGMENT.name[i]<128) text[j++] = SEGMENT.name[i];
-
-  if (!strlen(text)
-    || !strncmp_P(text,PSTR("#DATE"),5)
-    || !strncmp_P(text,PSTR("#DDMM"),5)
-    || !strncmp_P(text,PSTR("#MMDD"),5)
-    || !strncmp_P(text,PSTR("#TIME"),5)
-    || !strncmp_P(text,PSTR("#HHMM"),5)) { // fallback if empty segment name: display date and time
-    char sec[5];
-    byte AmPmHour = hour(localTime);
-    boolean isitAM = true;
-    if (useAMPM) {
-      if (AmPmHour > 11) { AmPmHour -= 12; isitAM = false; }
-      if (AmPmHour == 0) { AmPmHour  = 12; }
-    }
-    if (useAMPM) sprintf_P(sec, PSTR(" %2s"), (isitAM ? "AM" : "PM"));
-    else         sprintf_P(sec, PSTR(":%02d"), second(localTime));
-    if      (!strncmp_P(text,PSTR("#DATE"),5)) sprintf_P(text, zero?PSTR("%02d.%02d.%04d"):PSTR("%d.%d.%d"), day(localTime), month(localTime), year(localTime));
-    else if (!strncmp_P(text,PSTR("#DDMM"),5)) sprintf_P(text, zero?PSTR("%02d.%02d"):PSTR("%d.%d"), day(localTime), month(localTime));
-    else if (!strncmp_P(text,PSTR("#MMDD"),5)) sprintf_P(text, zero?PSTR("%02d/%02d"):PSTR("%d/%d"), month(localTime), day(localTime));
-    else if (!strncmp_P(text,PSTR("#TIME"),5)) sprintf_P(text, zero?PSTR("%02d:%02d%s"):PSTR("%2d:%02d%s"), AmPmHour, minute(localTime), sec);
-    else if (!strncmp_P(text,PSTR("#HHMM"),5)) sprintf_P(text, zero?PSTR("%02d:%02d"):PSTR("%d:%02d"), AmPmHour, minute(localTime));
-    else sprintf_P(text, zero?PSTR("%s %02d, %04d %02d:%02d%s"):PSTR("%s %d, %d %d:%02d%s"), monthShortStr(month(localTime)), day(localTime), year(localTime), AmPmHour, minute(localTime), sec);
-  }
-  const int numberOfLetters = strlen(text);
+
+  if (SEGENV.call == 0 || cache->expanded != localTime || cache->font != fontKey) {
+    char text[SCROLLTEXT_MAX_CHARS+1] = {'\0'};
+    if (SEGMENT.name) for (size_t i=0,j=0; i<strlen(SEGMENT.name) && j<SCROLLTEXT_MAX_CHARS; i++) if (SEGMENT.name[i]>31 && SEGMENT.name[i]<128) text[j++] = SEGMENT.name[i];
+
+    if (!strlen(text)
+      || !strncmp_P(text,PSTR("#DATE"),5)
+      || !strncmp_P(text,PSTR("#DDMM"),5)
+      || !strncmp_P(text,PSTR("#MMDD"),5)
+      || !strncmp_P(text,PSTR("#TIME"),5)
+      || !strncmp_P(text,PSTR("#HHMM"),5)) { // fallback if empty segment name: display date and time
+      char sec[5];
+      byte AmPmHour = hour(localTime);
+      boolean isitAM = true;
+      if (useAMPM) {
+        if (AmPmHour > 11) { AmPmHour -= 12; isitAM = false; }
+        if (AmPmHour == 0) { AmPmHour  = 12; }
+      }
+      if (useAMPM) sprintf_P(sec, PSTR(" %2s"), (isitAM ? "AM" : "PM"));
+      else         sprintf_P(sec, PSTR(":%02d"), second(localTime));
+      if      (!strncmp_P(text,PSTR("#DATE"),5)) sprintf_P(text, zero?PSTR("%02d.%02d.%04d"):PSTR("%d.%d.%d"), day(localTime), month(localTime), year(localTime));
+      else if (!strncmp_P(text,PSTR("#DDMM"),5)) sprintf_P(text, zero?PSTR("%02d.%02d"):PSTR("%d.%d"), day(localTime), month(localTime));
+      else if (!strncmp_P(text,PSTR("#MMDD"),5)) sprintf_P(text, zero?PSTR("%02d/%02d"):PSTR("%d/%d"), month(localTime), day(localTime));
+      else if (!strncmp_P(text,PSTR("#TIME"),5)) sprintf_P(text, zero?PSTR("%02d:%02d%s"):PSTR("%2d:%02d%s"), AmPmHour, minute(localTime), sec);
+      else if (!strncmp_P(text,PSTR("#HHMM"),5)) sprintf_P(text, zero?PSTR("%02d:%02d"):PSTR("%d:%02d"), AmPmHour, minute(localTime));
+      else sprintf_P(text, zero?PSTR("%s %02d, %04d %02d:%02d%s"):PSTR("%s %d, %d %d:%02d%s"), monthShortStr(month(localTime)), day(localTime), year(localTime), AmPmHour, minute(localTime), sec);
+    }
+    cache->expanded = localTime;
+
+    if (SEGENV.call == 0 || cache->font != fontKey || strcmp(text, cache->text)) {
+      strlcpy(cache->text, text, sizeof(cache->text));
+      cache->font  = fontKey;
+      cache->width = SEGMENT.rasterizeText(cache->text, letterWidth, letterHeight, cache->columns, sizeof(cache->columns)/sizeof(uint16_t));
+    }
+  }
+  const int textWidth = cache->width;
 
   if (SEGENV.step < millis()) {
-    if ((numberOfLetters * letterWidth) > cols) ++SEGENV.aux0 %= (numberOfLetters * letterWidth) + cols;      // offset
-    else                                          SEGENV.aux0  = (cols + (numberOfLetters * letterWidth))/2;
+    if (textWidth > cols) ++SEGENV.aux0 %= textWidth + cols;      // offset
+    else                  SEGENV.aux0  = (cols + textWidth)/2;
     ++SEGENV.aux1 &= 0xFF; // color shift
     SEGENV.step = millis() + map(SEGMENT.speed, 0, 255, 10*FRAMETIME_FIXED, 2*FRAMETIME_FIXED);
     if (!SEGMENT.check2) {
@@ -5916,19 +6226,18 @@ uint16_t mode_2Dscrollingtext(void) {
         SEGMENT.blendPixelColorXY(x, y, SEGCOLOR(1), 255 - (SEGMENT.custom1>>1));
     }
   }
-  for (int i = 0; i < numberOfLetters; i++) {
-    if (int(cols) - int(SEGENV.aux0) + letterWidth*(i+1) < 0) continue; // don't draw characters off-screen
-    uint32_t col1 = SEGMENT.color_from_palette(SEGENV.aux1, false, PALETTE_SOLID_WRAP, 0);
-    uint32_t col2 = BLACK;
-    if (SEGMENT.check1 && SEGMENT.palette == 0) {
-      col1 = SEGCOLOR(0);
-      col2 = SEGCOLOR(2);
-    }
-    SEGMENT.drawCharacter(text[i], int(cols) - int(SEGENV.aux0) + letterWidth*i, yoffset, letterWidth, letterHeight, col1, col2);
+
+  uint32_t col1 = SEGMENT.color_from_palette(SEGENV.aux1, false, PALETTE_SOLID_WRAP, 0);
+  uint32_t col2 = BLACK;
+  if (SEGMENT.check1 && SEGMENT.palette == 0) {
+    col1 = SEGCOLOR(0);
+    col2 = SEGCOLOR(2);
   }
+  SEGMENT.drawRasterizedText(cache->columns, textWidth, int(cols) - int(SEGENV.aux0), yoffset, letterHeight, col1, col2);
 
   return FRAMETIME;
 }
+#undef SCROLLTEXT_MAX_CHARS
 static const char _data_FX_MODE_2DSCROLLTEXT[] PROGMEM = "Scrolling Text@!,Y Offset,Trail,Font size,,Gradient,Overlay,0;!,!,Gradient;!;2;ix=128,c1=0,rev=0,mi=0,rY=0,mY=0";
 
 
@@ -5953,8 +6262,16 @@ uint16_t mode_2Ddriftrose(void) {
 
   SEGMENT.fadeToBlackBy(32+(SEGMENT.speed>>3));
   for (size_t i = 1; i < 37; i++) {
+#if WLED_FX_FIXED_MATH
+    // all values in half pixels: 2*CX, 2*(beatsin8()-L); sin16() is Q15
+    const int32_t  d2 = 2*beatsin8(i, 0, L*2) - int(L*2);
+    const uint16_t a  = i * 10 * 65536L / 360;
+    uint32_t x = ((cols-cols%2-1) * 255 + ((((int32_t)sin16(a) * d2) >> 7) * 255 >> 8)) / 2;
+    uint32_t y = ((rows-rows%2-1) * 255 + ((((int32_t)cos16(a) * d2) >> 7) * 255 >> 8)) / 2;
+#else
     uint32_t x = (CX + (sin_t(radians(i * 10)) * (beatsin8(i, 0, L*2)-L))) * 255.f;
     uint32_t y = (CY + (cos_t(radians(i * 10)) * (beatsin8(i, 0, L*2)-L))) * 255.f;
+#endif
     SEGMENT.wu_pixel(x, y, CHSV(i * 10, 255, 255));
   }
   SEGMENT.blur((SEGMENT.intensity>>4)+1);
@@ -6387,7 +6704,7 @@ uint16_t mode_matripix(void) {                  // Matripix. By Andrew Tuline.
     SEGENV.aux0 = secondHand;
 
     int pixBri = volumeRaw * SEGMENT.intensity / 64;
-    for (int i = 0; i < SEGLEN-1; i++) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // shift left
+    SEGMENT.shift(1); // shift left
     SEGMENT.setPixelColor(SEGLEN-1, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(millis(), false, PALETTE_SOLID_WRAP, 0), pixBri));
   }
 
@@ -6835,7 +7152,7 @@ uint16_t mode_freqmatrix(void) {                // Freqmatrix. By Andreas Plesch
 
     // shift the pixels one pixel up
     SEGMENT.setPixelColor(0, color);
-    for (int i = SEGLEN - 1; i > 0; i--) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i-1)); //move to the left
+    SEGMENT.shift(-1); //move to the left
   }
 
   return FRAMETIME;
@@ -7111,7 +7428,7 @@ uint16_t mode_waterfall(void) {                   // Waterfall. By: Andrew Tulin
     } else {
       SEGMENT.setPixelColor(SEGLEN-1, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(pixCol+SEGMENT.intensity, false, PALETTE_SOLID_WRAP, 0), (int)my_magnitude));
     }
-    for (int i = 0; i < SEGLEN-1; i++) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // shift left
+    SEGMENT.shift(1); // shift left
   }
 
   return FRAMETIME;
@@ -7186,7 +7503,6 @@ uint16_t mode_2DFunkyPlank(void) {              // Written by ??? Adapted by Wil
   if (!strip.isMatrix) return mode_static(); // not a 2D set-up
 
   const uint16_t cols = SEGMENT.virtualWidth();
-  const uint16_t rows = SEGMENT.virtualHeight();
 
   int NUMB_BANDS = map(SEGMENT.custom1, 0, 255, 1, 16);
   int barWidth = (cols / NUMB_BANDS);
@@ -7225,11 +7541,7 @@ uint16_t mode_2DFunkyPlank(void) {              // Written by ??? Adapted by Wil
     }
 
     // Update the display:
-    for (int i = (rows - 1); i > 0; i--) {
-      for (int j = (cols - 1); j >= 0; j--) {
-        SEGMENT.setPixelColorXY(j, i, SEGMENT.getPixelColorXY(j, i-1));
-      }
-    }
+    SEGMENT.moveY(-1);
   }
 
   return FRAMETIME;
@@ -7540,8 +7852,9 @@ uint16_t mode_2Doctopus() {
     const uint8_t C_Y = rows / 2 + (SEGMENT.custom2 - 128)*rows/255;
     for (int x = 0; x < cols; x++) {
       for (int y = 0; y < rows; y++) {
-        rMap[XY(x, y)].angle = 40.7436f * atan2f(y - C_Y, x - C_X); // avoid 128*atan2()/PI
-        rMap[XY(x, y)].radius = hypotf(x - C_X, y - C_Y) * mapp; //thanks Sutaburosu
+        const int dx = x - C_X, dy = y - C_Y;
+        rMap[XY(x, y)].angle = atan2_16_t(dy, dx) >> 8; // 256 = full circle
+        rMap[XY(x, y)].radius = sqrt_t(float(dx*dx + dy*dy)) * mapp; //thanks Sutaburosu
       }
     }
   }
@@ -56,6 +56,16 @@
 #define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
 #endif
 
+// use fixed-point inner loops in float heavy 2D effects (Julia, Drift Rose, Ghost Rider)
+// defaults to fixed-point on MCUs without FPU, override with -D WLED_FX_FIXED_MATH=0/1
+#ifndef WLED_FX_FIXED_MATH
+  #if defined(ESP8266) || defined(CONFIG_IDF_TARGET_ESP32C3)
+    #define WLED_FX_FIXED_MATH 1
+  #else
+    #define WLED_FX_FIXED_MATH 0
+  #endif
+#endif
+
 /* Not used in all effects yet */
 #define WLED_FPS         42
 #define FRAMETIME_FIXED  (1000/WLED_FPS)
@@ -83,6 +93,27 @@
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / strip.getMaxSegments())
 
+/* How many segments may crossfade between effects at the same time (if WS2812FX::crossfadeEffects is set).
+  Each crossfade takes 2 buffers of getLengthTotal() pixels (4 bytes each) from a pool allocated once. */
+#ifndef WLED_MAX_CROSSFADES
+  #ifdef ESP8266
+    #define WLED_MAX_CROSSFADES 1
+  #else
+    #define WLED_MAX_CROSSFADES 2
+  #endif
+#endif
+static_assert(WLED_MAX_CROSSFADES <= 8, "WLED_MAX_CROSSFADES exceeds the 8 bit pool slot mask");
+
+/* How many different noise fields may be cached by WS2812FX::getNoiseField() at the same time.
+  Segments requesting a field with identical parameters in the same frame share it. */
+#ifndef WLED_MAX_NOISE_FIELDS
+  #ifdef ESP8266
+    #define WLED_MAX_NOISE_FIELDS 2
+  #else
+    #define WLED_MAX_NOISE_FIELDS 4
+  #endif
+#endif
+
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
 #define NUM_COLORS       3 /* number of colors per segment */
@@ -329,16 +360,29 @@ typedef enum mapping1D2D {
   M12_pCorner = 3
 } mapping1D2D_t;
 
-// segment, 72 bytes
+// noise field request (see WS2812FX::getNoiseField()), value at column i and row j is
+// inoise8(x + i*xi + j*xj, y + i*yi + j*yj, z) so 1D fields (h=1) may also run diagonally
+// with dims == 2 z is ignored and 2D noise inoise8(x + i*xi + j*xj, y + i*yi + j*yj) is used
+typedef struct NoiseParams {
+  uint16_t w, h;     // field size
+  uint16_t x, y, z;  // origin
+  uint16_t xi, yi;   // coordinate step per column
+  uint16_t xj, yj;   // coordinate step per row
+  uint8_t  octaves;  // 1-4, each octave doubles the frequency and halves the amplitude
+  uint8_t  lattice;  // 1, 2, 4 or 8: sample every n-th pixel and interpolate in between
+  uint8_t  dims;     // 2: 2D noise (no z axis), 3: 3D noise
+} noiseParams;
+
+// segment, 120 bytes on ESP32; members used every frame occupy the first 40
 typedef struct Segment {
   public:
+    // Members are ordered by access frequency: geometry, options and runtime data
+    // used by WS2812FX::service() and pixel routing on every frame come first so the
+    // scheduler's working set per segment stays within one cache line;
+    // configuration that only changes on user action follows.
     uint16_t start; // start index / start X coordinate 2D (left)
     uint16_t stop;  // stop index / stop X coordinate 2D (right); segment is invalid if stop == 0
     uint16_t offset;
-    uint8_t  speed;
-    uint8_t  intensity;
-    uint8_t  palette;
-    uint8_t  mode;
     union {
       uint16_t options; //bit pattern: msb first: [transposed mirrorY reverseY] transitional (tbd) paused needspixelstate mirrored on reverse selected
       struct {
@@ -359,8 +403,25 @@ typedef struct Segment {
     };
     uint8_t  grouping, spacing;
     uint8_t  opacity;
-    uint32_t colors[NUM_COLORS];
+    uint8_t  mode;
+    uint8_t  startY;  // start Y coodrinate 2D (top); there should be no more than 255 rows
+    uint8_t  stopY;   // stop Y coordinate 2D (bottom); there should be no more than 255 rows
+
+    // runtime data
+    unsigned long next_time;  // millis() of next update
+    uint32_t step;  // custom "step" var
+    uint32_t call;  // call counter
+    uint16_t aux0;  // custom var
+    uint16_t aux1;  // custom var
+    byte* data;     // effect data pointer
+    CRGB* leds;     // local leds[] array (may be a pointer to global)
+
+    // configuration (cold)
+    uint8_t  speed;
+    uint8_t  intensity;
+    uint8_t  palette;
     uint8_t  cct;                 //0==1900K, 255==10091K
+    uint32_t colors[NUM_COLORS];
     uint8_t  custom1, custom2;    // custom FX parameters/sliders
     struct {
       uint8_t custom3 : 5;        // reduced range slider (0-31)
@@ -368,18 +429,13 @@ typedef struct Segment {
       bool    check2  : 1;        // checkmark 2
       bool    check3  : 1;        // checkmark 3
     };
-    uint8_t startY;  // start Y coodrinate 2D (top); there should be no more than 255 rows
-    uint8_t stopY;   // stop Y coordinate 2D (bottom); there should be no more than 255 rows
+    uint8_t  keyframes; // effect keyframe rate in FPS (0 = off), frames in between are interpolated
+    uint8_t  liveSrc;    // realtime source bound to this segment (LIVE_SRC_*), other segments keep running effects
+    uint8_t  liveLayout; // channel layout of bound realtime data (LIVE_LAYOUT_*)
+    bool     liveGamma;  // apply gamma correction to bound realtime data
+    uint16_t liveStart;  // first universe (LIVE_SRC_UNIVERSE) or first pixel (LIVE_SRC_DDP) of bound realtime data
     char *name;
 
-    // runtime data
-    unsigned long next_time;  // millis() of next update
-    uint32_t step;  // custom "step" var
-    uint32_t call;  // call counter
-    uint16_t aux0;  // custom var
-    uint16_t aux1;  // custom var
-    byte* data;     // effect data pointer
-    CRGB* leds;     // local leds[] array (may be a pointer to global)
     static CRGB *_globalLeds;             // global leds[] array
     static uint16_t maxWidth, maxHeight;  // these define matrix width & height (max. segment dimensions)
 
@@ -397,6 +453,37 @@ typedef struct Segment {
     uint16_t _dataLen;
     static uint16_t _usedSegmentData;
 
+    // keyframe interpolation data, valid only if keyframes>0
+    uint32_t *_kf;      // retained effect output: two keyframes of _kfLen pixels each
+    uint16_t  _kfLen;   // number of pixels in one keyframe
+    uint16_t  _kfDur;   // time from latest keyframe to the next one (ms), 0 if not interpolating
+    uint32_t  _kfStart; // strip.now when latest keyframe was rendered
+    bool      _kfFlip;  // which half of _kf holds the latest keyframe
+
+    uint32_t *_renderBuf; // if set, effect output is redirected into this buffer (virtual pixels, used for crossfading)
+    uint32_t  _liveLast;  // millis() when bound realtime data was last received, 0 if none
+
+    // pixel write paths, specialized for current segment configuration while effect is running (see selectPixelWriters())
+    typedef void (Segment::*PixelWriter)(int, uint32_t);
+    PixelWriter _pixelWriter;
+  #ifndef WLED_DISABLE_2D
+    typedef void (Segment::*PixelWriterXY)(int, int, uint32_t);
+    PixelWriterXY _pixelWriterXY;
+  #endif
+    void setPixelColorGeneric(int n, uint32_t c); // handles every segment feature (opacity, transition, 2D mapping, grouping, ...)
+    void setPixelColorToBuffer(int n, uint32_t c);   // writes into _renderBuf
+    template<bool reversed, bool grouped, bool mirrored> void setPixelColor1D(int n, uint32_t c); // full opacity, no leds[], 1D only
+  #ifndef WLED_DISABLE_2D
+    void setPixelColorXYGeneric(int x, int y, uint32_t c);
+    void setPixelColorXYRowMajor(int x, int y, uint32_t c); // full opacity, no leds[], no grouping/mirroring/reversing/transposing
+    void setPixelColorXYToBuffer(int x, int y, uint32_t c);
+  #endif
+    template<typename T> static void shiftBuffer(T *buf, int len, int delta, bool wrap); // in place block move of a line of pixels (uint32_t or CRGB)
+  #ifndef WLED_DISABLE_2D
+    void moveLine(bool column, uint16_t n, int delta, bool wrap); // moveRow()/moveColumn() implementation
+    void fillVacated(bool column, uint16_t n, int delta, uint32_t c); // sets pixels vacated by moveLine() to c
+  #endif
+
     // transition data, valid only if transitional==true, holds values during transition
     struct Transition {
       uint32_t      _colorT[NUM_COLORS];
@@ -405,9 +492,12 @@ typedef struct Segment {
       CRGBPalette16 _palT;        // temporary palette
       uint8_t       _prevPaletteBlends; // number of previous palette blends (there are max 255 belnds possible)
       uint8_t       _modeP;       // previous mode/effect
-      //uint16_t      _aux0, _aux1; // previous mode/effect runtime data
-      //uint32_t      _step, _call; // previous mode/effect runtime data
-      //byte         *_data;        // previous mode/effect runtime data
+      bool          _xfTried;     // crossfade was attempted (it may have been skipped)
+      uint16_t      _aux0, _aux1; // previous mode/effect runtime data (valid while crossfading)
+      uint32_t      _step, _call; // previous mode/effect runtime data (valid while crossfading)
+      byte         *_data;        // previous mode/effect runtime data (valid while crossfading)
+      uint16_t      _dataLen;
+      uint32_t     *_buf;         // crossfade buffers from strip pool (previous & new effect output), nullptr if not crossfading
       uint32_t      _start;
       uint16_t      _dur;
       Transition(uint16_t dur=750)
@@ -416,6 +506,10 @@ typedef struct Segment {
         , _palT(CRGBPalette16(CRGB::Black))
         , _prevPaletteBlends(0)
         , _modeP(FX_MODE_STATIC)
+        , _xfTried(false)
+        , _data(nullptr)
+        , _dataLen(0)
+        , _buf(nullptr)
         , _start(millis())
         , _dur(dur)
       {}
@@ -425,6 +519,10 @@ typedef struct Segment {
         , _palT(CRGBPalette16(CRGB::Black))
         , _prevPaletteBlends(0)
         , _modeP(FX_MODE_STATIC)
+        , _xfTried(false)
+        , _data(nullptr)
+        , _dataLen(0)
+        , _buf(nullptr)
         , _start(millis())
         , _dur(d)
       {
@@ -432,31 +530,22 @@ typedef struct Segment {
       }
     } *_t;
 
+    void startCrossfade(void); // move outgoing effect's runtime data into transition
+    void endCrossfade(void);   // release outgoing effect's runtime data and crossfade buffers
+
   public:
 
     Segment(uint16_t sStart=0, uint16_t sStop=30) :
       start(sStart),
       stop(sStop),
       offset(0),
-      speed(DEFAULT_SPEED),
-      intensity(DEFAULT_INTENSITY),
-      palette(0),
-      mode(DEFAULT_MODE),
       options(SELECTED | SEGMENT_ON),
       grouping(1),
       spacing(0),
       opacity(255),
-      colors{DEFAULT_COLOR,BLACK,BLACK},
-      cct(127),
-      custom1(DEFAULT_C1),
-      custom2(DEFAULT_C2),
-      custom3(DEFAULT_C3),
-      check1(false),
-      check2(false),
-      check3(false),
+      mode(DEFAULT_MODE),
       startY(0),
       stopY(1),
-      name(nullptr),
       next_time(0),
       step(0),
       call(0),
@@ -464,8 +553,36 @@ typedef struct Segment {
       aux1(0),
       data(nullptr),
       leds(nullptr),
+      speed(DEFAULT_SPEED),
+      intensity(DEFAULT_INTENSITY),
+      palette(0),
+      cct(127),
+      colors{DEFAULT_COLOR,BLACK,BLACK},
+      custom1(DEFAULT_C1),
+      custom2(DEFAULT_C2),
+      custom3(DEFAULT_C3),
+      check1(false),
+      check2(false),
+      check3(false),
+      keyframes(0),
+      liveSrc(LIVE_SRC_NONE),
+      liveLayout(LIVE_LAYOUT_RGB),
+      liveGamma(true),
+      liveStart(1),
+      name(nullptr),
       _capabilities(0),
       _dataLen(0),
+      _kf(nullptr),
+      _kfLen(0),
+      _kfDur(0),
+      _kfStart(0),
+      _kfFlip(false),
+      _renderBuf(nullptr),
+      _liveLast(0),
+      _pixelWriter(&Segment::setPixelColorGeneric),
+    #ifndef WLED_DISABLE_2D
+      _pixelWriterXY(&Segment::setPixelColorXYGeneric),
+    #endif
       _t(nullptr)
     {
       //refreshLightCapabilities();
@@ -489,15 +606,16 @@ typedef struct Segment {
       //#endif
       if (!Segment::_globalLeds && leds) free(leds);
       if (name) delete[] name;
-      if (_t) delete _t;
+      if (_t) { endCrossfade(); delete _t; }
       deallocateData();
+      deallocateKeyframes();
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (!Segment::_globalLeds && leds?sizeof(CRGB)*length():0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (!Segment::_globalLeds && leds?sizeof(CRGB)*length():0) + (_kf?2*sizeof(uint32_t)*_kfLen:0); }
 #endif
 
     inline bool     getOption(uint8_t n) const { return ((options >> n) & 0x01); }
@@ -539,11 +657,30 @@ typedef struct Segment {
       */
     inline void markForReset(void) { reset = true; }  // setOption(SEG_OPTION_RESET, true)
     void setUpLeds(void);   // set up leds[] array for loseless getPixelColor()
+    void selectPixelWriters(void); // pick specialized setPixelColor() paths for current configuration (valid until resetPixelWriters())
+    void resetPixelWriters(void);  // revert to generic setPixelColor() paths
+
+    // segment bound realtime data
+    uint8_t  liveBytesPerPixel(void) const { return liveLayout >= LIVE_LAYOUT_RGBW ? 4 : 3; }
+    uint16_t liveLength(void) const;  // number of pixels accepted (virtual, rows first on 2D)
+    bool     isLive(void) const;      // bound realtime data received recently, effect is paused
+    void     setLivePixels(uint16_t first, const uint8_t *data, uint16_t count); // count pixels in liveLayout from virtual pixel first
+
+    // keyframe interpolation functions
+    bool     allocateKeyframes(void);
+    void     deallocateKeyframes(void);
+    inline bool keyframeDue(uint32_t now) const { return !keyframes || !_kf || !_kfDur || now - _kfStart >= _kfDur; }
+    void     restoreKeyframe(void);             // put latest keyframe back so effect continues from its own output
+    uint16_t storeKeyframe(uint16_t delay);     // capture effect output, returns delay until next service
+    uint16_t interpolateKeyframes(uint32_t now); // blend between last two keyframes, returns delay until next service
 
     // transition functions
     void     startTransition(uint16_t dur); // transition has to start before actual segment values change
     void     handleTransition(void);
     uint16_t progress(void); //transition progression between 0-65535
+    inline bool    isCrossfading(void) const { return transitional && _t && _t->_buf; }
+    inline uint8_t crossfadeMode(void) const { return _t->_modeP; } // outgoing effect, valid only if isCrossfading()
+    uint16_t renderCrossfade(uint16_t (*fxOld)(void), uint16_t (*fxNew)(void)); // render both effects and blend them
     uint8_t  currentBri(uint8_t briNew, bool useCct = false);
     uint8_t  currentMode(uint8_t modeNew);
     uint32_t currentColor(uint8_t slot, uint32_t colorNew);
@@ -552,7 +689,7 @@ typedef struct Segment {
 
     // 1D strip
     uint16_t virtualLength(void) const;
-    void setPixelColor(int n, uint32_t c); // set relative pixel within segment with color
+    inline void setPixelColor(int n, uint32_t c) { (this->*_pixelWriter)(n, c); } // set relative pixel within segment with color
     void setPixelColor(int n, byte r, byte g, byte b, byte w = 0) { setPixelColor(n, RGBW32(r,g,b,w)); } // automatically inline
     void setPixelColor(int n, CRGB c)                             { setPixelColor(n, RGBW32(c.r,c.g,c.b,0)); } // automatically inline
     void setPixelColor(float i, uint32_t c, bool aa = true);
@@ -564,6 +701,8 @@ typedef struct Segment {
     void fill(uint32_t c);
     void fade_out(uint8_t r);
     void fadeToBlackBy(uint8_t fadeBy);
+    void shift(int delta, bool wrap = false);   // move all pixels by delta (positive delta towards start), vacated pixels keep their color
+    void shift(int delta, bool wrap, uint32_t fill); // as above but vacated pixels are set to fill
     void blendPixelColor(int n, uint32_t color, uint8_t blend);
     void blendPixelColor(int n, CRGB c, uint8_t blend)            { blendPixelColor(n, RGBW32(c.r,c.g,c.b,0), blend); }
     void addPixelColor(int n, uint32_t color, bool fast = false);
@@ -580,7 +719,7 @@ typedef struct Segment {
     uint16_t nrOfVStrips(void) const;
   #ifndef WLED_DISABLE_2D
     uint16_t XY(uint16_t x, uint16_t y); // support function to get relative index within segment (for leds[])
-    void setPixelColorXY(int x, int y, uint32_t c); // set relative pixel within segment with color
+    inline void setPixelColorXY(int x, int y, uint32_t c) { (this->*_pixelWriterXY)(x, y, c); } // set relative pixel within segment with color
     void setPixelColorXY(int x, int y, byte r, byte g, byte b, byte w = 0) { setPixelColorXY(x, y, RGBW32(r,g,b,w)); } // automatically inline
     void setPixelColorXY(int x, int y, CRGB c)                             { setPixelColorXY(x, y, RGBW32(c.r,c.g,c.b,0)); } // automatically inline
     void setPixelColorXY(float x, float y, uint32_t c, bool aa = true);
@@ -599,14 +738,21 @@ typedef struct Segment {
     void blurCol(uint16_t col, fract8 blur_amount);
     void moveX(int8_t delta, bool wrap = false);
     void moveY(int8_t delta, bool wrap = false);
+    void moveRow(uint16_t row, int delta, bool wrap = false);
+    void moveRow(uint16_t row, int delta, bool wrap, uint32_t fill);    // vacated pixels are set to fill
+    void moveColumn(uint16_t col, int delta, bool wrap = false);
+    void moveColumn(uint16_t col, int delta, bool wrap, uint32_t fill); // vacated pixels are set to fill
     void move(uint8_t dir, uint8_t delta, bool wrap = false);
-    void draw_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c);
+    void drawSpan(int x0, int x1, int y, uint32_t c); // horizontal run of pixels, clipped to segment
+    void draw_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c, bool soft = false);
     void fill_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c);
-    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c);
-    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, CRGB c) { drawLine(x0, y0, x1, y1, RGBW32(c.r,c.g,c.b,0)); } // automatic inline
+    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c, bool soft = false);
+    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, CRGB c, bool soft = false) { drawLine(x0, y0, x1, y1, RGBW32(c.r,c.g,c.b,0), soft); } // automatic inline
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color, uint32_t col2 = 0);
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB c) { drawCharacter(chr, x, y, w, h, RGBW32(c.r,c.g,c.b,0)); } // automatic inline
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB c, CRGB c2) { drawCharacter(chr, x, y, w, h, RGBW32(c.r,c.g,c.b,0), RGBW32(c2.r,c2.g,c2.b,0)); } // automatic inline
+    static uint16_t rasterizeText(const char *text, uint8_t w, uint8_t h, uint16_t *columns, uint16_t maxColumns); // 1 bit per pixel glyph strip (text cache)
+    void drawRasterizedText(const uint16_t *columns, uint16_t width, int16_t x, int16_t y, uint8_t h, uint32_t color, uint32_t col2 = 0);
     void wu_pixel(uint32_t x, uint32_t y, CRGB c);
     void blur1d(fract8 blur_amount); // blur all rows in 1 dimension
     void blur2d(fract8 blur_amount) { blur(blur_amount); }
@@ -632,12 +778,20 @@ typedef struct Segment {
     void blurCol(uint16_t col, fract8 blur_amount) {}
     void moveX(int8_t delta, bool wrap = false) {}
     void moveY(int8_t delta, bool wrap = false) {}
+    void moveRow(uint16_t row, int delta, bool wrap = false) {}
+    void moveRow(uint16_t row, int delta, bool wrap, uint32_t fill) {}
+    void moveColumn(uint16_t col, int delta, bool wrap = false) {}
+    void moveColumn(uint16_t col, int delta, bool wrap, uint32_t fill) {}
     void move(uint8_t dir, uint8_t delta, bool wrap = false) {}
+    void drawSpan(int x0, int x1, int y, uint32_t c) {}
+    void draw_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c, bool soft = false) {}
     void fill_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c) {}
-    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c) {}
-    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, CRGB c) {}
+    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c, bool soft = false) {}
+    void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, CRGB c, bool soft = false) {}
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color) {}
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB color) {}
+    static uint16_t rasterizeText(const char *text, uint8_t w, uint8_t h, uint16_t *columns, uint16_t maxColumns) { return 0; }
+    void drawRasterizedText(const uint16_t *columns, uint16_t width, int16_t x, int16_t y, uint8_t h, uint32_t color, uint32_t col2 = 0) {}
     void wu_pixel(uint32_t x, uint32_t y, CRGB c) {}
   #endif
 } segment;
@@ -692,7 +846,12 @@ class WS2812FX {  // 96 bytes
       customMappingSize(0),
       _lastShow(0),
       _segment_index(0),
-      _mainSegment(0)
+      _mainSegment(0),
+      _xfPool(nullptr),
+      _xfLen(0),
+      _xfUsed(0),
+      _xfSkipped(0),
+      _noise{}
     {
       WS2812FX::instance = this;
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
@@ -711,6 +870,8 @@ class WS2812FX {  // 96 bytes
 #endif
       customPalettes.clear();
       if (useLedsArray && Segment::_globalLeds) free(Segment::_globalLeds);
+      if (_xfPool) free(_xfPool);
+      releaseNoiseFields(true);
     }
 
     static WS2812FX* getInstance(void) { return instance; }
@@ -735,6 +896,7 @@ class WS2812FX {  // 96 bytes
       makeAutoSegments(bool forceReset = false),
       fixInvalidSegments(),
       setPixelColor(int n, uint32_t c),
+      setPixelColors(uint16_t n, const uint32_t *c, uint16_t len), // span of consecutive pixels (realtime ingest)
       show(void),
       setTargetFps(uint8_t fps);
 
@@ -758,7 +920,8 @@ class WS2812FX {  // 96 bytes
       // return true if the strip is being sent pixel updates
       isUpdating(void),
       deserializeMap(uint8_t n=0),
-      useLedsArray = false;
+      useLedsArray = false,
+      crossfadeEffects = false; // keep rendering previous effect during transition and crossfade it with the new one
 
     inline bool isServicing(void) { return _isServicing; }
     inline bool hasWhiteChannel(void) {return _hasWhiteChannel;}
@@ -795,6 +958,14 @@ class WS2812FX {  // 96 bytes
     inline uint16_t getMinShowDelay(void) { return MIN_SHOW_DELAY; }
     inline uint16_t getLength(void) { return _length; } // 2D matrix may have less pixels than W*H
     inline uint16_t getTransition(void) { return _transitionDur; }
+    inline uint16_t getSkippedCrossfades(void) { return _xfSkipped; } // crossfades not done because buffer pool was exhausted
+    inline uint16_t getCrossfadeBufferLength(void) { return _xfLen; }
+
+    bool      allocateCrossfadePool(void);     // false if postponed because a crossfade is running
+    uint32_t *acquireCrossfadeBuffers(void);   // returns 2 buffers of getLengthTotal() pixels from pool or nullptr
+    void      releaseCrossfadeBuffers(uint32_t *buf);
+
+    const uint8_t *getNoiseField(const NoiseParams &p); // w*h noise values, shared within a frame (nullptr if out of memory)
 
     uint32_t
       now,
@@ -905,7 +1076,20 @@ class WS2812FX {  // 96 bytes
     uint8_t _segment_index;
     uint8_t _mainSegment;
 
+    uint32_t *_xfPool;    // crossfade buffer pool (WLED_MAX_CROSSFADES * 2 * getLengthTotal() pixels)
+    uint16_t  _xfLen;     // length of a single buffer in pool
+    uint8_t   _xfUsed;    // bitmask of pool slots in use (max 8)
+    uint16_t  _xfSkipped; // number of crossfades skipped due to exhausted pool
+
+    struct {
+      NoiseParams params;
+      uint8_t    *data;  // w*h values followed by 2 rows of lattice samples
+      size_t      size;  // allocated bytes
+      uint32_t    frame; // now when generated
+    } _noise[WLED_MAX_NOISE_FIELDS];
+
     void
+      releaseNoiseFields(bool all = false),
       estimateCurrentAndLimitBri(void);
 };
 
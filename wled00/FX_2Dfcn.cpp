@@ -194,7 +194,7 @@ uint16_t /*IRAM_ATTR*/ Segment::XY(uint16_t x, uint16_t y) {
   return (x%width) + (y%height) * width;
 }
 
-void /*IRAM_ATTR*/ Segment::setPixelColorXY(int x, int y, uint32_t col)
+void /*IRAM_ATTR*/ Segment::setPixelColorXYGeneric(int x, int y, uint32_t col)
 {
   if (Segment::maxHeight==1) return; // not a matrix set-up
   if (x >= virtualWidth() || y >= virtualHeight() || x<0 || y<0) return;  // if pixel would fall out of virtual segment just exit
@@ -241,6 +241,20 @@ void /*IRAM_ATTR*/ Segment::setPixelColorXY(int x, int y, uint32_t col)
   }
 }
 
+// setPixelColorXY() for plain row-major segments at full opacity without leds[] (selected in selectPixelWriters())
+void /*IRAM_ATTR*/ Segment::setPixelColorXYRowMajor(int x, int y, uint32_t col)
+{
+  if (unsigned(x) >= width() || unsigned(y) >= height()) return;  // if pixel would fall out of segment just exit
+  strip.setPixelColorXY(start + x, startY + y, col);
+}
+
+// redirected setPixelColorXY() used while rendering effects for crossfade
+void /*IRAM_ATTR*/ Segment::setPixelColorXYToBuffer(int x, int y, uint32_t col)
+{
+  if (unsigned(x) >= virtualWidth() || unsigned(y) >= virtualHeight()) return;
+  _renderBuf[x + y * virtualWidth()] = col;
+}
+
 // anti-aliased version of setPixelColorXY()
 void Segment::setPixelColorXY(float x, float y, uint32_t col, bool aa)
 {
@@ -267,10 +281,10 @@ void Segment::setPixelColorXY(float x, float y, uint32_t col, bool aa)
     uint32_t cXRYB = getPixelColorXY(xR, yB);
 
     if (xL!=xR && yT!=yB) {
-      setPixelColorXY(xL, yT, color_blend(col, cXLYT, uint8_t(sqrtf(dL*dT)*255.0f))); // blend TL pixel
-      setPixelColorXY(xR, yT, color_blend(col, cXRYT, uint8_t(sqrtf(dR*dT)*255.0f))); // blend TR pixel
-      setPixelColorXY(xL, yB, color_blend(col, cXLYB, uint8_t(sqrtf(dL*dB)*255.0f))); // blend BL pixel
-      setPixelColorXY(xR, yB, color_blend(col, cXRYB, uint8_t(sqrtf(dR*dB)*255.0f))); // blend BR pixel
+      setPixelColorXY(xL, yT, color_blend(col, cXLYT, uint8_t(sqrt_t(dL*dT)*255.0f))); // blend TL pixel
+      setPixelColorXY(xR, yT, color_blend(col, cXRYT, uint8_t(sqrt_t(dR*dT)*255.0f))); // blend TR pixel
+      setPixelColorXY(xL, yB, color_blend(col, cXLYB, uint8_t(sqrt_t(dL*dB)*255.0f))); // blend BL pixel
+      setPixelColorXY(xR, yB, color_blend(col, cXRYB, uint8_t(sqrt_t(dR*dB)*255.0f))); // blend BR pixel
     } else if (xR!=xL && yT==yB) {
       setPixelColorXY(xR, yT, color_blend(col, cXLYT, uint8_t(dL*255.0f))); // blend L pixel
       setPixelColorXY(xR, yT, color_blend(col, cXRYT, uint8_t(dR*255.0f))); // blend R pixel
@@ -287,6 +301,7 @@ void Segment::setPixelColorXY(float x, float y, uint32_t col, bool aa)
 
 // returns RGBW values of pixel
 uint32_t Segment::getPixelColorXY(uint16_t x, uint16_t y) {
+  if (_renderBuf) return (x < virtualWidth() && y < virtualHeight()) ? _renderBuf[x + y * virtualWidth()] : 0;
   int i = XY(x,y);
   if (leds) return RGBW32(leds[i].r, leds[i].g, leds[i].b, 0);
   if (reverse  ) x = virtualWidth()  - x - 1;
@@ -300,6 +315,13 @@ uint32_t Segment::getPixelColorXY(uint16_t x, uint16_t y) {
 
 // Blends the specified color with the existing pixel color.
 void Segment::blendPixelColorXY(uint16_t x, uint16_t y, uint32_t color, uint8_t blend) {
+  if (_renderBuf) { // blend in place, no read-back through the pixel mapping
+    if (x < virtualWidth() && y < virtualHeight()) {
+      uint32_t &pix = _renderBuf[x + y * virtualWidth()];
+      pix = color_blend(pix, color, blend);
+    }
+    return;
+  }
   setPixelColorXY(x, y, color_blend(getPixelColorXY(x,y), color, blend));
 }
 
@@ -430,38 +452,90 @@ void Segment::blur1d(fract8 blur_amount) {
   for (uint16_t y = 0; y < rows; y++) blurRow(y, blur_amount);
 }
 
-void Segment::moveX(int8_t delta, bool wrap) {
+// moveLine() - shift a single row (or column) by delta pixels (positive delta moves towards 0)
+// Rows held in a buffer (_renderBuf while crossfading, leds[] if the segment has one) are moved as a block,
+// leds[] is then written out without reading back from the bus. Otherwise (and for columns) the line is
+// read once and only pixels that actually change are written back.
+void Segment::moveLine(bool column, uint16_t n, int delta, bool wrap) {
   const uint16_t cols = virtualWidth();
   const uint16_t rows = virtualHeight();
-  if (!delta || abs(delta) >= cols) return;
-  uint32_t newPxCol[cols];
-  for (int y = 0; y < rows; y++) {
-    if (delta > 0) {
-      for (int x = 0; x < cols-delta; x++)    newPxCol[x] = getPixelColorXY((x + delta), y);
-      for (int x = cols-delta; x < cols; x++) newPxCol[x] = getPixelColorXY(wrap ? (x + delta) - cols : x, y);
-    } else {
-      for (int x = cols-1; x >= -delta; x--) newPxCol[x] = getPixelColorXY((x + delta), y);
-      for (int x = -delta-1; x >= 0; x--)    newPxCol[x] = getPixelColorXY(wrap ? (x + delta) + cols : x, y);
+  const int len = column ? rows : cols;
+  if (!delta || abs(delta) >= len || n >= (column ? cols : rows)) return;
+  if (_renderBuf && !column) { // rows are contiguous in the render buffer
+    shiftBuffer(&_renderBuf[n * cols], len, delta, wrap);
+    return;
+  }
+  if (leds && !column) { // and in leds[]
+    CRGB *row = &leds[XY(0, n)];
+    shiftBuffer(row, len, delta, wrap);
+    for (int i = 0; i < len; i++) setPixelColorXY(i, int(n), RGBW32(row[i].r, row[i].g, row[i].b, 0));
+    return;
+  }
+  uint32_t line[len];
+  for (int i = 0; i < len; i++) line[i] = column ? getPixelColorXY(n, i) : getPixelColorXY(i, n);
+  for (int i = 0; i < len; i++) {
+    int src = i + delta;
+    if (src < 0 || src >= len) {
+      if (!wrap) continue; // vacated pixel keeps its color
+      src += src < 0 ? len : -len;
     }
-    for (int x = 0; x < cols; x++) setPixelColorXY(x, y, newPxCol[x]);
+    if (line[src] == line[i]) continue;
+    if (column) setPixelColorXY(int(n), i, line[src]);
+    else        setPixelColorXY(i, int(n), line[src]);
   }
 }
 
+// sets the pixels of row/column n that moveLine(column, n, delta, false) left behind to c
+void Segment::fillVacated(bool column, uint16_t n, int delta, uint32_t c) {
+  const int len = column ? virtualHeight() : virtualWidth();
+  const int cnt = MIN(abs(delta), len);
+  if (!cnt || n >= (column ? virtualWidth() : virtualHeight())) return;
+  const int first = delta > 0 ? len - cnt : 0;
+  if (!column) { drawSpan(first, first + cnt - 1, n, c); return; } // block fill in _renderBuf or leds[]
+  for (int i = first; i < first + cnt; i++) setPixelColorXY(int(n), i, c);
+}
+
+void Segment::moveRow(uint16_t row, int delta, bool wrap) {
+  moveLine(false, row, delta, wrap);
+}
+
+void Segment::moveRow(uint16_t row, int delta, bool wrap, uint32_t fill) {
+  moveLine(false, row, delta, wrap);
+  if (!wrap) fillVacated(false, row, delta, fill);
+}
+
+void Segment::moveColumn(uint16_t col, int delta, bool wrap) {
+  moveLine(true, col, delta, wrap);
+}
+
+void Segment::moveColumn(uint16_t col, int delta, bool wrap, uint32_t fill) {
+  moveLine(true, col, delta, wrap);
+  if (!wrap) fillVacated(true, col, delta, fill);
+}
+
+void Segment::moveX(int8_t delta, bool wrap) {
+  const uint16_t rows = virtualHeight();
+  if (!delta || abs(delta) >= virtualWidth()) return;
+  for (int y = 0; y < rows; y++) moveLine(false, y, delta, wrap);
+}
+
 void Segment::moveY(int8_t delta, bool wrap) {
   const uint16_t cols = virtualWidth();
   const uint16_t rows = virtualHeight();
   if (!delta || abs(delta) >= rows) return;
-  uint32_t newPxCol[rows];
-  for (int x = 0; x < cols; x++) {
-    if (delta > 0) {
-      for (int y = 0; y < rows-delta; y++)    newPxCol[y] = getPixelColorXY(x, (y + delta));
-      for (int y = rows-delta; y < rows; y++) newPxCol[y] = getPixelColorXY(x, wrap ? (y + delta) - rows : y);
-    } else {
-      for (int y = rows-1; y >= -delta; y--) newPxCol[y] = getPixelColorXY(x, (y + delta));
-      for (int y = -delta-1; y >= 0; y--)    newPxCol[y] = getPixelColorXY(x, wrap ? (y + delta) + rows : y);
+  if (_renderBuf) { // rows are contiguous: a single block move of the whole buffer
+    shiftBuffer(_renderBuf, cols * rows, delta * cols, wrap);
+    return;
+  }
+  if (leds) {
+    shiftBuffer(leds, cols * rows, delta * cols, wrap);
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
+      const CRGB &c = leds[XY(x, y)];
+      setPixelColorXY(x, y, RGBW32(c.r, c.g, c.b, 0));
     }
-    for (int y = 0; y < rows; y++) setPixelColorXY(x, y, newPxCol[y]);
+    return;
   }
+  for (int x = 0; x < cols; x++) moveLine(true, x, delta, wrap);
 }
 
 // move() - move all pixels in desired direction delta number of pixels
@@ -482,7 +556,53 @@ void Segment::move(uint8_t dir, uint8_t delta, bool wrap) {
   }
 }
 
-void Segment::draw_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB col) {
+// horizontal span of pixels (x0..x1 inclusive) clipped to the segment
+// rows are contiguous in _renderBuf and leds[], so the span is filled there as a block (like moveRow())
+void Segment::drawSpan(int x0, int x1, int y, uint32_t c) {
+  const int cols = virtualWidth();
+  if (y < 0 || y >= virtualHeight()) return;
+  if (x0 > x1) std::swap(x0, x1);
+  x0 = MAX(x0, 0);
+  x1 = MIN(x1, cols-1);
+  if (x0 > x1) return;
+  if (_renderBuf) {
+    std::fill_n(&_renderBuf[x0 + y * cols], x1 - x0 + 1, c);
+    return;
+  }
+  if (leds) {
+    std::fill_n(&leds[XY(x0, y)], x1 - x0 + 1, CRGB(c));
+    for (int x = x0; x <= x1; x++) setPixelColorXY(x, y, c);
+    return;
+  }
+  for (int x = x0; x <= x1; x++) setPixelColorXY(x, y, c);
+}
+
+// plot (a,b) mirrored into all four quadrants around (cx,cy), each pixel only once
+static void circleQuad(Segment &seg, int cx, int cy, int a, int b, uint32_t c, uint8_t alpha) {
+  if (!alpha) return;
+  seg.blendPixelColorXY(cx + a, cy + b, c, alpha);
+  if (a)      seg.blendPixelColorXY(cx - a, cy + b, c, alpha);
+  if (b)      seg.blendPixelColorXY(cx + a, cy - b, c, alpha);
+  if (a && b) seg.blendPixelColorXY(cx - a, cy - b, c, alpha);
+}
+
+void Segment::draw_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB col, bool soft) {
+  if (soft) {
+    // Wu's circle: exact outline height per column in 8.8 fixed point, split between the two nearest pixels
+    const uint32_t c = RGBW32(col.r, col.g, col.b, 0);
+    const uint32_t r2 = radius * radius;
+    for (int x = 0; x <= radius; x++) {
+      uint32_t yq = sqrt32_t((r2 - x*x) << 16);
+      int y = yq >> 8;
+      uint8_t f = yq & 0xFF;
+      if (y < x) break; // first octant done, the rest is mirrored
+      circleQuad(*this, cx, cy, x, y,   c, 255 - f);
+      circleQuad(*this, cx, cy, x, y+1, c, f);
+      if (x != y)   circleQuad(*this, cx, cy, y,   x, c, 255 - f);
+      if (x != y+1) circleQuad(*this, cx, cy, y+1, x, c, f);
+    }
+    return;
+  }
   // Bresenham’s Algorithm
   int d = 3 - (2*radius);
   int y = radius, x = 0;
@@ -506,16 +626,13 @@ void Segment::draw_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB col) {
 }
 
 // by stepko, taken from https://editor.soulmatelights.com/gallery/573-blobs
+// drawn as one horizontal span per scanline
 void Segment::fill_circle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB col) {
-  const uint16_t cols = virtualWidth();
-  const uint16_t rows = virtualHeight();
-  for (int16_t y = -radius; y <= radius; y++) {
-    for (int16_t x = -radius; x <= radius; x++) {
-      if (x * x + y * y <= radius * radius &&
-          int16_t(cx)+x>=0 && int16_t(cy)+y>=0 &&
-          int16_t(cx)+x<cols && int16_t(cy)+y<rows)
-        setPixelColorXY(cx + x, cy + y, col);
-    }
+  const uint32_t c = RGBW32(col.r, col.g, col.b, 0);
+  const int r2 = radius * radius;
+  for (int y = -radius; y <= radius; y++) {
+    int hw = sqrt32_t(r2 - y*y); // half width of the scanline
+    drawSpan(int(cx) - hw, int(cx) + hw, int(cy) + y, c);
   }
 }
 
@@ -528,10 +645,31 @@ void Segment::nscale8(uint8_t scale) {
 }
 
 //line function
-void Segment::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c) {
+void Segment::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c, bool soft) {
   const uint16_t cols = virtualWidth();
   const uint16_t rows = virtualHeight();
   if (x0 >= cols || x1 >= cols || y0 >= rows || y1 >= rows) return;
+  if (y0 == y1) { drawSpan(x0, x1, y0, c); return; } // horizontal line is a single span
+  if (soft) {
+    // Xiaolin Wu's algorithm, 16.16 fixed point
+    const bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+    if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+    const int32_t gradient = ((int32_t(y1) - y0) << 16) / (x1 - x0); // x1 > x0 as line is not horizontal
+    int32_t intery = int32_t(y0) << 16;
+    for (int x = x0; x <= x1; x++, intery += gradient) {
+      int y = intery >> 16;
+      uint8_t f = (intery >> 8) & 0xFF;
+      if (steep) {
+        blendPixelColorXY(y, x, c, 255 - f);
+        if (f) blendPixelColorXY(y + 1, x, c, f);
+      } else {
+        blendPixelColorXY(x, y, c, 255 - f);
+        if (f) blendPixelColorXY(x, y + 1, c, f);
+      }
+    }
+    return;
+  }
   const int16_t dx = abs(x1-x0), sx = x0<x1 ? 1 : -1;
   const int16_t dy = abs(y1-y0), sy = y0<y1 ? 1 : -1;
   int16_t err = (dx>dy ? dx : -dy)/2, e2;
@@ -550,6 +688,19 @@ void Segment::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint3
 #include "src/font/console_font_6x8.h"
 #include "src/font/console_font_7x9.h"
 
+// returns one row of a raster font character (bit 7 is leftmost column), font is w*h
+static bool fontRow(int font, unsigned char chr, uint8_t h, int i, uint8_t &bits) {
+  switch (font) {
+    case 24: bits = pgm_read_byte_near(&console_font_4x6[(chr * h) + i]); break;  // 5x8 font
+    case 40: bits = pgm_read_byte_near(&console_font_5x8[(chr * h) + i]); break;  // 5x8 font
+    case 48: bits = pgm_read_byte_near(&console_font_6x8[(chr * h) + i]); break;  // 6x8 font
+    case 63: bits = pgm_read_byte_near(&console_font_7x9[(chr * h) + i]); break;  // 7x9 font
+    case 60: bits = pgm_read_byte_near(&console_font_5x12[(chr * h) + i]); break; // 5x12 font
+    default: return false;
+  }
+  return true;
+}
+
 // draws a raster font character on canvas
 // only supports: 4x6=24, 5x8=40, 5x12=60, 6x8=48 and 7x9=63 fonts ATM
 void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color, uint32_t col2) {
@@ -568,14 +719,7 @@ void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w,
     if (y0 < 0) continue; // drawing off-screen
     if (y0 >= rows) break; // drawing off-screen
     uint8_t bits = 0;
-    switch (font) {
-      case 24: bits = pgm_read_byte_near(&console_font_4x6[(chr * h) + i]); break;  // 5x8 font
-      case 40: bits = pgm_read_byte_near(&console_font_5x8[(chr * h) + i]); break;  // 5x8 font
-      case 48: bits = pgm_read_byte_near(&console_font_6x8[(chr * h) + i]); break;  // 6x8 font
-      case 63: bits = pgm_read_byte_near(&console_font_7x9[(chr * h) + i]); break;  // 7x9 font
-      case 60: bits = pgm_read_byte_near(&console_font_5x12[(chr * h) + i]); break; // 5x12 font
-      default: return;
-    }
+    if (!fontRow(font, chr, h, i, bits)) return;
     col = ColorFromPalette(grad, (i+1)*255/h, 255, NOBLEND);
     for (int j = 0; j<w; j++) { // character width
       int16_t x0 = x + (w-1) - j;
@@ -586,6 +730,54 @@ void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w,
   }
 }
 
+// rasterizes text into a strip of w*strlen(text) pixel columns (bit i of a column is glyph row i)
+// characters outside ASCII 32-126 leave blank columns; returns number of columns used
+uint16_t Segment::rasterizeText(const char *text, uint8_t w, uint8_t h, uint16_t *columns, uint16_t maxColumns) {
+  const int font = w*h;
+  uint8_t bits;
+  if (h > 16 || !fontRow(font, 0, h, 0, bits)) return 0; // unsupported font
+  uint16_t width = 0;
+  for (size_t c = 0; text[c] && width + w <= maxColumns; c++, width += w) {
+    uint16_t *glyph = &columns[width];
+    memset(glyph, 0, w * sizeof(uint16_t));
+    unsigned char chr = text[c];
+    if (chr < 32 || chr > 126) continue;
+    chr -= 32; // align with font table entries
+    for (int i = 0; i<h; i++) {
+      fontRow(font, chr, h, i, bits);
+      for (int j = 0; j<w; j++) if ((bits >> (7-j)) & 0x01) glyph[j] |= 1 << i;
+    }
+  }
+  return width;
+}
+
+// draws text rasterized by rasterizeText() with its left edge at x, only visible columns are processed
+void Segment::drawRasterizedText(const uint16_t *columns, uint16_t width, int16_t x, int16_t y, uint8_t h, uint32_t color, uint32_t col2) {
+  const int cols = virtualWidth();
+  const int rows = virtualHeight();
+  const int x0 = MAX(0, (int)x);
+  const int x1 = MIN(cols, (int)x + (int)width);
+  const int y0 = MAX(0, (int)y);
+  const int y1 = MIN(rows, (int)y + (int)h);
+  if (x0 >= x1 || y0 >= y1) return;
+
+  // vertical gradient is the same for every column
+  CRGB col = CRGB(color);
+  CRGBPalette16 grad = CRGBPalette16(col, col2 ? CRGB(col2) : col);
+  uint32_t rowColor[16];
+  for (int i = y0 - y; i < y1 - y; i++) {
+    CRGB c = ColorFromPalette(grad, (i+1)*255/h, 255, NOBLEND);
+    rowColor[i] = RGBW32(c.r, c.g, c.b, 0);
+  }
+
+  for (int px = x0; px < x1; px++) {
+    uint16_t bits = columns[px - x] >> (y0 - y);
+    for (int py = y0; bits && py < y1; py++, bits >>= 1) {
+      if (bits & 0x01) setPixelColorXY(px, py, rowColor[py - y]);
+    }
+  }
+}
+
 #define WU_WEIGHT(a,b) ((uint8_t) (((a)*(b)+(a)+(b))>>8))
 void Segment::wu_pixel(uint32_t x, uint32_t y, CRGB c) {      //awesome wu_pixel procedure by reddit u/sutaburosu
   // extract the fractional parts and derive their inverses
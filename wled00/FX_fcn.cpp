@@ -73,7 +73,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 // Segment class implementation
 ///////////////////////////////////////////////////////////////////////////////
-uint16_t Segment::_usedSegmentData = 0U; // amount of RAM all segments use for their data[]
+uint16_t Segment::_usedSegmentData = 0U; // amount of RAM all segments use for their data[] (and keyframes)
 CRGB    *Segment::_globalLeds = nullptr;
 uint16_t Segment::maxWidth = DEFAULT_LED_COUNT;
 uint16_t Segment::maxHeight = 1;
@@ -86,6 +86,9 @@ Segment::Segment(const Segment &orig) {
   data = nullptr;
   _dataLen = 0;
   _t = nullptr;
+  _kf = nullptr; // keyframes are not copied, they will be re-rendered
+  _kfLen = 0;
+  _renderBuf = nullptr;
   if (leds && !Segment::_globalLeds) leds = nullptr;
   if (orig.name) { name = new char[strlen(orig.name)+1]; if (name) strcpy(name, orig.name); }
   if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
@@ -102,6 +105,8 @@ Segment::Segment(Segment &&orig) noexcept {
   orig._dataLen = 0;
   orig._t   = nullptr;
   orig.leds = nullptr;
+  orig._kf  = nullptr;
+  orig._kfLen = 0;
 }
 
 // copy assignment
@@ -110,9 +115,10 @@ Segment& Segment::operator= (const Segment &orig) {
   if (this != &orig) {
     // clean destination
     if (name) delete[] name;
-    if (_t)   delete _t;
+    if (_t)   { endCrossfade(); delete _t; }
     if (leds && !Segment::_globalLeds) free(leds);
     deallocateData();
+    deallocateKeyframes();
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     // erase pointers to allocated data
@@ -120,6 +126,9 @@ Segment& Segment::operator= (const Segment &orig) {
     data = nullptr;
     _dataLen = 0;
     _t = nullptr;
+    _kf = nullptr;
+    _kfLen = 0;
+    _renderBuf = nullptr;
     if (!Segment::_globalLeds) leds = nullptr;
     // copy source data
     if (orig.name) { name = new char[strlen(orig.name)+1]; if (name) strcpy(name, orig.name); }
@@ -136,14 +145,17 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
   if (this != &orig) {
     if (name) delete[] name; // free old name
     deallocateData(); // free old runtime data
-    if (_t) delete _t;
+    if (_t) { endCrossfade(); delete _t; }
     if (leds && !Segment::_globalLeds) free(leds);
+    deallocateKeyframes();
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
     orig._t   = nullptr;
     orig.leds = nullptr;
+    orig._kf  = nullptr;
+    orig._kfLen = 0;
   }
   return *this;
 }
@@ -186,6 +198,7 @@ void Segment::resetIfRequired() {
     if (leds && !Segment::_globalLeds) { free(leds); leds = nullptr; }
     //if (transitional && _t) { transitional = false; delete _t; _t = nullptr; }
     deallocateData();
+    deallocateKeyframes();
     next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
     reset = false; // setOption(SEG_OPTION_RESET, false);
   }
@@ -193,6 +206,7 @@ void Segment::resetIfRequired() {
 
 void Segment::setUpLeds() {
   // deallocation happens in resetIfRequired() as it is called when segment changes or in destructor
+  if (!_renderBuf) resetPixelWriters(); // leds[] need to be updated by every write
   if (Segment::_globalLeds)
     #ifndef WLED_DISABLE_2D
     leds = &Segment::_globalLeds[start + startY*Segment::maxWidth];
@@ -209,6 +223,82 @@ void Segment::setUpLeds() {
   }
 }
 
+/**
+  * Keyframe interpolation: expensive effects are rendered only every 1000/keyframes ms,
+  * frames in between are blended from the last two keyframes (i.e. output lags one keyframe).
+  * Keyframes are stored in virtual (effect) coordinates so they can be written back
+  * before the effect runs again; effects relying on previous pixel state remain unaffected.
+  * Keyframes count towards MAX_SEGMENT_DATA, if they do not fit the effect is rendered every frame.
+  */
+bool Segment::allocateKeyframes() {
+  uint16_t len = is2D() ? virtualWidth() * virtualHeight() : virtualLength();
+  if (_kf && _kfLen == len) return true; //already allocated
+  deallocateKeyframes();
+  if (len == 0) return false;
+  const size_t size = 2 * sizeof(uint32_t) * len;
+  if (Segment::getUsedSegmentData() + size > MAX_SEGMENT_DATA) return false; //not enough memory
+  _kf = (uint32_t*) malloc(size);
+  if (!_kf) return false; //allocation failed
+  Segment::addUsedSegmentData(size);
+  _kfLen = len;
+  return true;
+}
+
+void Segment::deallocateKeyframes() {
+  if (_kf) {
+    free(_kf);
+    Segment::addUsedSegmentData(-2 * (int)sizeof(uint32_t) * _kfLen);
+  }
+  _kf = nullptr;
+  _kfLen = 0;
+  _kfDur = 0;
+}
+
+void Segment::restoreKeyframe() {
+  if (!_kf || !_kfDur) return; // nothing was interpolated since latest keyframe
+  const uint32_t *latest = _kf + (_kfFlip ? _kfLen : 0);
+  int cols = is2D() ? virtualWidth() : virtualLength();
+  int rows = is2D() ? virtualHeight() : 1;
+  for (int y = 0, i = 0; y < rows; y++) for (int x = 0; x < cols; x++, i++) {
+    if (rows > 1) setPixelColorXY(x, y, latest[i]);
+    else          setPixelColor(x, latest[i]);
+  }
+}
+
+uint16_t Segment::storeKeyframe(uint16_t delay) {
+  if (!keyframes) { deallocateKeyframes(); return delay; }
+  bool valid = _kf && _kfLen == (is2D() ? virtualWidth() * virtualHeight() : virtualLength());
+  if (!allocateKeyframes()) return delay;
+  _kfFlip = !_kfFlip; // latest keyframe becomes previous
+  uint32_t *latest = _kf + (_kfFlip ? _kfLen : 0);
+  int cols = is2D() ? virtualWidth() : virtualLength();
+  int rows = is2D() ? virtualHeight() : 1;
+  for (int y = 0, i = 0; y < rows; y++) for (int x = 0; x < cols; x++, i++) {
+    latest[i] = rows > 1 ? getPixelColorXY(x, y) : getPixelColor(x);
+  }
+  if (!valid) memcpy(_kf + (_kfFlip ? 0 : _kfLen), latest, sizeof(uint32_t) * _kfLen); // first keyframe, nothing to blend from
+  uint16_t kfDelay = 1000 / keyframes;
+  // effect is already slower than keyframe rate (or in transition): keep its timing
+  _kfDur = (delay >= kfDelay || transitional) ? 0 : kfDelay;
+  _kfStart = strip.now;
+  return _kfDur ? FRAMETIME : delay;
+}
+
+uint16_t Segment::interpolateKeyframes(uint32_t now) {
+  uint32_t elapsed = now - _kfStart;
+  uint8_t blend = elapsed >= _kfDur ? 255 : (elapsed << 8) / _kfDur;
+  const uint32_t *prev   = _kf + (_kfFlip ? 0 : _kfLen);
+  const uint32_t *latest = _kf + (_kfFlip ? _kfLen : 0);
+  int cols = is2D() ? virtualWidth() : virtualLength();
+  int rows = is2D() ? virtualHeight() : 1;
+  for (int y = 0, i = 0; y < rows; y++) for (int x = 0; x < cols; x++, i++) {
+    uint32_t c = color_blend(prev[i], latest[i], blend);
+    if (rows > 1) setPixelColorXY(x, y, c);
+    else          setPixelColor(x, c);
+  }
+  return FRAMETIME;
+}
+
 CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   static unsigned long _lastPaletteChange = 0; // perhaps it should be per segment
   static CRGBPalette16 randomPalette = CRGBPalette16(DEFAULT_COLOR);
@@ -369,8 +459,10 @@ void Segment::handleTransition() {
   if (!transitional) return;
   uint16_t _progress = progress();
   if (_t) { // thanks to @nXm AKA https://github.com/NMeirer
-    if (_progress >= 32767U && _t->_modeP != mode) markForReset();
+    if (_t->_modeP != mode && !_t->_xfTried && _progress < 0xFFFFU) startCrossfade();
+    if (_progress >= 32767U && _t->_modeP != mode && !_t->_buf) markForReset(); // crossfading effects were reset at start
     if (_progress == 0xFFFFU) {
+      endCrossfade();
       delete _t;
       _t = nullptr;
     }
@@ -378,6 +470,82 @@ void Segment::handleTransition() {
   if (_progress == 0xFFFFU) transitional = false; // finish transitioning segment
 }
 
+/**
+  * Effect crossfade: when the effect changes during a transition (and crossfading is enabled)
+  * the outgoing effect keeps its runtime data and is rendered into a pooled buffer while the
+  * incoming one starts from scratch in a second buffer. Both are blended into the segment.
+  * If the pool is exhausted the transition falls back to switching effects half way.
+  */
+void Segment::startCrossfade() {
+  _t->_xfTried = true;
+  if (!strip.crossfadeEffects) return;
+  _t->_buf = strip.acquireCrossfadeBuffers();
+  if (!_t->_buf) return;
+  // hand over runtime data to outgoing effect
+  _t->_data = data; _t->_dataLen = _dataLen;
+  _t->_step = step; _t->_call = call;
+  _t->_aux0 = aux0; _t->_aux1 = aux1;
+  data = nullptr; _dataLen = 0;
+  next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
+  if (leds && !Segment::_globalLeds) { free(leds); leds = nullptr; }
+  // both effects continue from current segment content
+  uint32_t *bufNew = _t->_buf + strip.getCrossfadeBufferLength();
+  int cols = is2D() ? virtualWidth() : virtualLength();
+  int rows = is2D() ? virtualHeight() : 1;
+  for (int y = 0, i = 0; y < rows; y++) for (int x = 0; x < cols; x++, i++) {
+    _t->_buf[i] = bufNew[i] = rows > 1 ? getPixelColorXY(x, y) : getPixelColor(x);
+  }
+}
+
+void Segment::endCrossfade() {
+  if (!_t || !_t->_buf) return;
+  strip.releaseCrossfadeBuffers(_t->_buf);
+  _t->_buf = nullptr;
+  if (_t->_data) {
+    free(_t->_data);
+    Segment::addUsedSegmentData(-_t->_dataLen);
+    _t->_data = nullptr;
+    _t->_dataLen = 0;
+  }
+}
+
+uint16_t Segment::renderCrossfade(uint16_t (*fxOld)(void), uint16_t (*fxNew)(void)) {
+  uint32_t *bufOld = _t->_buf;
+  uint32_t *bufNew = _t->_buf + strip.getCrossfadeBufferLength();
+  _pixelWriter = is2D() ? &Segment::setPixelColorGeneric : &Segment::setPixelColorToBuffer; // 2D maps to setPixelColorXY()
+#ifndef WLED_DISABLE_2D
+  _pixelWriterXY = &Segment::setPixelColorXYToBuffer;
+#endif
+
+  // outgoing effect
+  std::swap(data, _t->_data); std::swap(_dataLen, _t->_dataLen);
+  std::swap(step, _t->_step); std::swap(call, _t->_call);
+  std::swap(aux0, _t->_aux0); std::swap(aux1, _t->_aux1);
+  _renderBuf = bufOld;
+  (*fxOld)();
+  call++;
+  std::swap(data, _t->_data); std::swap(_dataLen, _t->_dataLen);
+  std::swap(step, _t->_step); std::swap(call, _t->_call);
+  std::swap(aux0, _t->_aux0); std::swap(aux1, _t->_aux1);
+
+  // incoming effect
+  _renderBuf = bufNew;
+  uint16_t delay = (*fxNew)();
+  _renderBuf = nullptr;
+  resetPixelWriters();
+
+  // blend both into segment
+  uint16_t prog = progress();
+  int cols = is2D() ? virtualWidth() : virtualLength();
+  int rows = is2D() ? virtualHeight() : 1;
+  for (int y = 0, i = 0; y < rows; y++) for (int x = 0; x < cols; x++, i++) {
+    uint32_t c = color_blend(bufOld[i], bufNew[i], prog, true);
+    if (rows > 1) setPixelColorXY(x, y, c);
+    else          setPixelColor(x, c);
+  }
+  return delay;
+}
+
 void Segment::setUp(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, uint16_t ofs, uint16_t i1Y, uint16_t i2Y) {
   //return if neither bounds nor grouping have changed
   bool boundsUnchanged = (start == i1 && stop == i2);
@@ -459,6 +627,7 @@ void Segment::setMode(uint8_t fx, bool loadDefaults) {
     if (fx != mode) {
       startTransition(strip.getTransition()); // set effect transitions
       //markForReset(); // transition will handle this
+      if (isCrossfading()) markForReset(); // incoming effect changed while crossfading, its runtime data must not be reused
       mode = fx;
 
       // load default values from effect string
@@ -549,7 +718,7 @@ uint16_t Segment::virtualLength() const {
   return vLength;
 }
 
-void IRAM_ATTR Segment::setPixelColor(int i, uint32_t col)
+void IRAM_ATTR Segment::setPixelColorGeneric(int i, uint32_t col)
 {
 #ifndef WLED_DISABLE_2D
   int vStrip = i>>16; // hack to allow running on virtual strips (2D segment columns/rows)
@@ -659,6 +828,110 @@ void IRAM_ATTR Segment::setPixelColor(int i, uint32_t col)
   }
 }
 
+// setPixelColor() specialized for 1D segments at full opacity without leds[] (selected in selectPixelWriters())
+// reversed/grouped/mirrored are resolved at compile time, remaining logic is the same as in setPixelColorGeneric()
+template<bool reversed, bool grouped, bool mirrored>
+void IRAM_ATTR Segment::setPixelColor1D(int i, uint32_t col)
+{
+  i &= 0xFFFF;
+  uint16_t len = length();
+  if (i >= ((grouped || mirrored) ? virtualLength() : len)) return;  // if pixel would fall out of segment just exit
+
+  if (grouped) i *= groupLength();
+  if (reversed) i = (mirrored ? (len - 1) / 2 : len - 1) - i;
+  i += start;
+
+  const int grp = grouped ? grouping : 1;
+  for (int j = 0; j < grp; j++) {
+    uint16_t indexSet = i + (reversed ? -j : j);
+    if (grouped && (indexSet < start || indexSet >= stop)) continue;
+    if (mirrored) {
+      uint16_t indexMir = stop - indexSet + start - 1 + offset;
+      if (indexMir >= stop) indexMir -= len; // wrap
+      strip.setPixelColor(indexMir, col);
+    }
+    indexSet += offset; // offset/phase
+    if (indexSet >= stop) indexSet -= len; // wrap
+    strip.setPixelColor(indexSet, col);
+  }
+}
+
+void Segment::selectPixelWriters() {
+  resetPixelWriters();
+  // opacity/transition need per pixel scaling and leds[] needs a copy, use generic paths
+  if (leds || transitional || !on || opacity < 255) return;
+#ifndef WLED_DISABLE_2D
+  if (is2D()) {
+    if (!reverse && !reverse_y && !mirror && !mirror_y && !transpose && groupLength() == 1) _pixelWriterXY = &Segment::setPixelColorXYRowMajor;
+    return;
+  }
+  if (Segment::maxHeight != 1 && (width() == 1 || height() == 1)) return; // 1D segment on a matrix is routed via setPixelColorXY()
+#endif
+  static const PixelWriter writers[8] = {
+    &Segment::setPixelColor1D<false,false,false>, &Segment::setPixelColor1D<true,false,false>,
+    &Segment::setPixelColor1D<false,true, false>, &Segment::setPixelColor1D<true,true, false>,
+    &Segment::setPixelColor1D<false,false,true >, &Segment::setPixelColor1D<true,false,true >,
+    &Segment::setPixelColor1D<false,true, true >, &Segment::setPixelColor1D<true,true, true >
+  };
+  _pixelWriter = writers[reverse | (groupLength() > 1) << 1 | mirror << 2];
+}
+
+void Segment::resetPixelWriters() {
+  _pixelWriter = &Segment::setPixelColorGeneric;
+#ifndef WLED_DISABLE_2D
+  _pixelWriterXY = &Segment::setPixelColorXYGeneric;
+#endif
+}
+
+/*
+ * Segment bound realtime data: packets of the source selected by liveSrc are written through the segment
+ * geometry (2D, grouping, mirroring, reverse) while other segments keep running their effects.
+ * The effect of a live segment is paused until no data arrived for realtimeTimeoutMs.
+ */
+uint16_t Segment::liveLength() const {
+#ifndef WLED_DISABLE_2D
+  if (is2D()) return virtualWidth() * virtualHeight();
+#endif
+  return virtualLength();
+}
+
+bool Segment::isLive() const {
+  return liveSrc != LIVE_SRC_NONE && _liveLast && millis() - _liveLast < realtimeTimeoutMs;
+}
+
+void Segment::setLivePixels(uint16_t first, const uint8_t *data, uint16_t count) {
+  // source channel of R, G, B and W for each layout (W 255 = none)
+  static const uint8_t layouts[LIVE_LAYOUT_COUNT][4] = { {0,1,2,255}, {1,0,2,255}, {2,1,0,255}, {0,1,2,3}, {1,0,2,3} };
+  const uint8_t *o = layouts[liveLayout < LIVE_LAYOUT_COUNT ? liveLayout : LIVE_LAYOUT_RGB];
+  const uint8_t bpp = liveBytesPerPixel();
+  const uint16_t len = liveLength();
+  if (first >= len) return;
+  if (count > len - first) count = len - first;
+#ifndef WLED_DISABLE_2D
+  const uint16_t cols = is2D() ? virtualWidth() : 0;
+#endif
+
+  selectPixelWriters();
+  for (uint16_t i = first; i < first + count; i++, data += bpp) {
+    uint8_t r = data[o[0]], g = data[o[1]], b = data[o[2]], w = o[3] < 4 ? data[o[3]] : 0;
+    if (liveGamma && gammaCorrectCol) { r = gamma8(r); g = gamma8(g); b = gamma8(b); w = gamma8(w); }
+  #ifndef WLED_DISABLE_2D
+    if (cols) setPixelColorXY(int(i % cols), int(i / cols), RGBW32(r, g, b, w));
+    else
+  #endif
+    setPixelColor(int(i), RGBW32(r, g, b, w));
+  }
+  resetPixelWriters();
+  _liveLast = millis() | 1;
+}
+
+// redirected setPixelColor() used while rendering effects for crossfade (1D segments)
+void IRAM_ATTR Segment::setPixelColorToBuffer(int i, uint32_t col)
+{
+  i &= 0xFFFF;
+  if (i < virtualLength()) _renderBuf[i] = col;
+}
+
 // anti-aliased normalized version of setPixelColor()
 void Segment::setPixelColor(float i, uint32_t col, bool aa)
 {
@@ -720,6 +993,7 @@ uint32_t Segment::getPixelColor(int i)
   }
 #endif
 
+  if (_renderBuf) return i < virtualLength() ? _renderBuf[i] : 0;
   if (leds) return RGBW32(leds[i].r, leds[i].g, leds[i].b, 0);
 
   if (reverse) i = virtualLength() - i - 1;
@@ -814,6 +1088,74 @@ void Segment::fill(uint32_t c) {
   }
 }
 
+/*
+ * Block move of a line of virtual pixels: buf[i] = buf[i+delta]
+ * vacated pixels wrap around or keep their previous value
+ */
+template<typename T>
+void Segment::shiftBuffer(T *buf, int len, int delta, bool wrap) {
+  const int n = abs(delta);
+  if (!delta || n >= len) return;
+  if (wrap) {
+    std::rotate(buf, buf + (delta > 0 ? n : len - n), buf + len);
+    return;
+  }
+  if (delta > 0) memmove(buf, buf + n, (len - n) * sizeof(T));
+  else           memmove(buf + n, buf, (len - n) * sizeof(T));
+}
+template void Segment::shiftBuffer<uint32_t>(uint32_t*, int, int, bool);
+template void Segment::shiftBuffer<CRGB>(CRGB*, int, int, bool);
+
+// shift() - move all pixels of a 1D segment by delta (positive delta moves towards the start, like moveX())
+// Pixels held in a buffer (_renderBuf while crossfading, leds[] if the segment has one) are moved as a block,
+// leds[] is then written out without reading back from the bus. Otherwise each pixel is read back from the bus.
+void Segment::shift(int delta, bool wrap) {
+  const int len = virtualLength();
+  if (!delta || len < 2) return;
+  if (wrap) {
+    delta %= len;
+    if (abs(delta) > len/2) delta += delta > 0 ? -len : len; // rotate the shorter way (fewer pixels to save)
+    if (!delta) return;
+  } else if (abs(delta) >= len) {
+    return;
+  }
+  if (_renderBuf && !is2D()) {
+    shiftBuffer(_renderBuf, len, delta, wrap);
+    return;
+  }
+  if (leds && !is2D()) {
+    shiftBuffer(leds, len, delta, wrap);
+    for (int i = 0; i < len; i++) setPixelColor(i, RGBW32(leds[i].r, leds[i].g, leds[i].b, 0));
+    return;
+  }
+  // pixels live in the bus: copy in place in the direction that never reads an already written pixel
+  const int n = abs(delta);
+  uint32_t saved[wrap ? n : 1];
+  if (delta > 0) {
+    if (wrap) for (int i = 0; i < n; i++) saved[i] = getPixelColor(i);
+    for (int i = 0; i < len - n; i++) setPixelColor(i, getPixelColor(i + n));
+    if (wrap) for (int i = 0; i < n; i++) setPixelColor(len - n + i, saved[i]);
+  } else {
+    if (wrap) for (int i = 0; i < n; i++) saved[i] = getPixelColor(len - n + i);
+    for (int i = len - 1; i >= n; i--) setPixelColor(i, getPixelColor(i - n));
+    if (wrap) for (int i = 0; i < n; i++) setPixelColor(i, saved[i]);
+  }
+}
+
+// shift() with vacated pixels set to fill (nothing is vacated when wrapping)
+void Segment::shift(int delta, bool wrap, uint32_t fill) {
+  shift(delta, wrap);
+  if (wrap || !delta) return;
+  const int len = virtualLength();
+  const int cnt = MIN(abs(delta), len);
+  const int first = delta > 0 ? len - cnt : 0;
+  if (_renderBuf && !is2D()) {
+    std::fill_n(&_renderBuf[first], cnt, fill);
+    return;
+  }
+  for (int i = first; i < first + cnt; i++) setPixelColor(i, fill);
+}
+
 // Blends the specified color with the existing pixel color.
 void Segment::blendPixelColor(int n, uint32_t color, uint8_t blend) {
   setPixelColor(n, color_blend(getPixelColor(n), color, blend));
@@ -1078,6 +1420,8 @@ void WS2812FX::finalizeInit(void)
     memset(Segment::_globalLeds, 0, arrSize);
   }
 
+  allocateCrossfadePool();
+
   //segments are created in makeAutoSegments();
   DEBUG_PRINTLN(F("Loading custom palettes"));
   loadCustomPalettes(); // (re)load all custom palettes
@@ -1085,6 +1429,127 @@ void WS2812FX::finalizeInit(void)
   deserializeMap();     // (re)load default ledmap
 }
 
+// (re)allocates crossfade buffer pool if LED count or crossfadeEffects changed (only possible while no crossfade is running)
+bool WS2812FX::allocateCrossfadePool() {
+  if (_xfUsed) return false;
+  size_t len = getLengthTotal();
+  if (_xfPool && (_xfLen != len || !crossfadeEffects)) {
+    free(_xfPool);
+    _xfPool = nullptr;
+  }
+  if (_xfPool || !crossfadeEffects || !len) return true;
+  _xfPool = (uint32_t*) malloc(WLED_MAX_CROSSFADES * 2 * sizeof(uint32_t) * len);
+  _xfLen = _xfPool ? len : 0;
+  if (!_xfPool) DEBUG_PRINTLN(F("Crossfade pool allocation failed."));
+  return true;
+}
+
+uint32_t *WS2812FX::acquireCrossfadeBuffers() {
+  if (_xfPool) {
+    for (unsigned slot = 0; slot < WLED_MAX_CROSSFADES; slot++) {
+      if (_xfUsed & (1U << slot)) continue;
+      _xfUsed |= 1U << slot;
+      return _xfPool + slot * 2 * _xfLen;
+    }
+  }
+  _xfSkipped++;
+  DEBUG_PRINTLN(F("Crossfade skipped, no free buffers."));
+  return nullptr;
+}
+
+void WS2812FX::releaseCrossfadeBuffers(uint32_t *buf) {
+  if (!_xfPool || !buf) return;
+  _xfUsed &= ~(1U << ((buf - _xfPool) / (2 * _xfLen)));
+}
+
+// single noise value, octaves add detail at double frequency and half amplitude
+static uint8_t noiseSample(const NoiseParams &p, int i, int j) {
+  uint16_t x = p.x + i*p.xi + j*p.xj;
+  uint16_t y = p.y + i*p.yi + j*p.yj;
+  if (p.octaves <= 1) return p.dims == 2 ? inoise8(x, y) : inoise8(x, y, p.z);
+  uint16_t sum = 0, total = 0;
+  for (unsigned o = 0, amp = 128; o < p.octaves; o++, amp >>= 1, x <<= 1, y <<= 1) {
+    sum   += ((p.dims == 2 ? inoise8(x, y) : inoise8(x, y, p.z)) * amp) >> 8;
+    total += amp;
+  }
+  return MIN(255, (sum << 8) / total);
+}
+
+// field by field, NoiseParams may contain padding
+static bool sameNoiseParams(const NoiseParams &a, const NoiseParams &b) {
+  return a.w == b.w && a.h == b.h && a.x == b.x && a.y == b.y && a.z == b.z &&
+         a.xi == b.xi && a.yi == b.yi && a.xj == b.xj && a.yj == b.yj &&
+         a.octaves == b.octaves && a.lattice == b.lattice && a.dims == b.dims;
+}
+
+// returns a w*h noise field for the current frame; segments asking for the same field in the
+// same frame get the cached one. With lattice > 1 only every n-th pixel (in both directions)
+// is sampled and the rest is bilinearly interpolated.
+const uint8_t *WS2812FX::getNoiseField(const NoiseParams &p) {
+  if (!p.w || !p.h) return nullptr;
+  int slot = -1;
+  for (int s = 0; s < WLED_MAX_NOISE_FIELDS; s++) {
+    if (_noise[s].data && sameNoiseParams(_noise[s].params, p)) {
+      if (_noise[s].frame == now) return _noise[s].data; // already generated in this frame
+      slot = s;
+      break;
+    }
+  }
+  if (slot < 0) { // take an empty slot or the least recently used one
+    slot = 0;
+    for (int s = 0; s < WLED_MAX_NOISE_FIELDS; s++) {
+      if (!_noise[s].data) { slot = s; break; }
+      if ((int32_t)(_noise[s].frame - _noise[slot].frame) < 0) slot = s; // older, also across now wrapping
+    }
+  }
+
+  const unsigned shift = p.lattice > 4 ? 3 : p.lattice > 2 ? 2 : p.lattice > 1 ? 1 : 0;
+  const int L  = 1 << shift;
+  const int cw = ((p.w + L - 1) >> shift) + 1; // lattice columns (last one covers right edge)
+  size_t size = p.w * p.h + (shift ? 2*cw : 0);
+  if (_noise[slot].size < size) {
+    free(_noise[slot].data);
+    _noise[slot].data = (uint8_t*) malloc(size);
+    _noise[slot].size = _noise[slot].data ? size : 0;
+    if (!_noise[slot].data) return nullptr;
+  }
+  uint8_t *d = _noise[slot].data;
+  _noise[slot].params = p;
+  _noise[slot].frame  = now;
+
+  if (!shift) {
+    for (int j = 0; j < p.h; j++) for (int i = 0; i < p.w; i++) *d++ = noiseSample(p, i, j);
+    return _noise[slot].data;
+  }
+
+  uint8_t *c0 = d + p.w * p.h; // lattice row above
+  uint8_t *c1 = c0 + cw;       // lattice row below
+  for (int ci = 0; ci < cw; ci++) c0[ci] = noiseSample(p, ci << shift, 0);
+  for (int j0 = 0; j0 < p.h; j0 += L) {
+    if (p.h > 1) for (int ci = 0; ci < cw; ci++) c1[ci] = noiseSample(p, ci << shift, j0 + L);
+    for (int dj = 0; dj < L && j0 + dj < p.h; dj++) {
+      uint8_t *row = &d[(j0 + dj) * p.w];
+      for (int ci = 0; (ci << shift) < p.w; ci++) {
+        int a = c0[ci]   + (((c1[ci]   - c0[ci])   * dj) >> shift); // vertical interpolation
+        int b = c0[ci+1] + (((c1[ci+1] - c0[ci+1]) * dj) >> shift);
+        for (int di = 0; di < L && (ci << shift) + di < p.w; di++) row[(ci << shift) + di] = a + (((b - a) * di) >> shift);
+      }
+    }
+    uint8_t *t = c0; c0 = c1; c1 = t;
+  }
+  return _noise[slot].data;
+}
+
+// frees noise fields not requested for a while (or all of them)
+void WS2812FX::releaseNoiseFields(bool all) {
+  for (int s = 0; s < WLED_MAX_NOISE_FIELDS; s++) {
+    if (!_noise[s].data || (!all && now - _noise[s].frame < 1000)) continue;
+    free(_noise[s].data);
+    _noise[s].data = nullptr;
+    _noise[s].size = 0;
+  }
+}
+
 void WS2812FX::service() {
   uint32_t nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
@@ -1108,7 +1573,13 @@ void WS2812FX::service() {
       doShow = true;
       uint16_t delay = FRAMETIME;
 
-      if (!seg.freeze) { //only run effect function if not frozen
+      seg.selectPixelWriters();
+      const bool paused = seg.freeze || seg.isLive(); // live segments show bound realtime data instead
+      if (!paused && !seg.keyframeDue(now)) { // interpolate between keyframes instead of running effect
+        _virtualSegmentLength = seg.virtualLength();
+        if (!cctFromRgb || correctWB) busses.setSegmentCCT(seg.currentBri(seg.cct, true), correctWB);
+        delay = seg.interpolateKeyframes(now);
+      } else if (!paused) { //only run effect function if not frozen
         _virtualSegmentLength = seg.virtualLength();
         _colors_t[0] = seg.currentColor(0, seg.colors[0]);
         _colors_t[1] = seg.currentColor(1, seg.colors[1]);
@@ -1120,11 +1591,14 @@ void WS2812FX::service() {
 
         // effect blending (execute previous effect)
         // actual code may be a bit more involved as effects have runtime data including allocated memory
-        //if (seg.transitional && seg._modeP) (*_mode[seg._modeP])(progress());
-        delay = (*_mode[seg.currentMode(seg.mode)])();
+        seg.restoreKeyframe();
+        if (seg.isCrossfading()) delay = seg.renderCrossfade(_mode[seg.crossfadeMode()], _mode[seg.mode]);
+        else                     delay = (*_mode[seg.currentMode(seg.mode)])();
         if (seg.mode != FX_MODE_HALLOWEEN_EYES) seg.call++;
         if (seg.transitional && delay > FRAMETIME) delay = FRAMETIME; // force faster updates during transition
+        delay = seg.storeKeyframe(delay);
       }
+      seg.resetPixelWriters();
 
       seg.next_time = nowUp + delay;
     }
@@ -1132,6 +1606,7 @@ void WS2812FX::service() {
   }
   _virtualSegmentLength = 0;
   busses.setSegmentCCT(-1);
+  releaseNoiseFields();
   if(doShow) {
     yield();
     show();
@@ -1147,6 +1622,17 @@ void IRAM_ATTR WS2812FX::setPixelColor(int i, uint32_t col)
   busses.setPixelColor(i, col);
 }
 
+void IRAM_ATTR WS2812FX::setPixelColors(uint16_t i, const uint32_t *col, uint16_t len)
+{
+  if (customMappingSize) { // mapped pixels are not consecutive on the bus, setPixelColor() checks each mapped index
+    for (uint16_t j = 0; j < len; j++) setPixelColor(i + j, col[j]);
+    return;
+  }
+  if (i >= _length) return;
+  if (len > _length - i) len = _length - i;
+  busses.setPixelColors(i, col, len);
+}
+
 uint32_t WS2812FX::getPixelColor(uint16_t i)
 {
   if (i < customMappingSize) i = customMappingTable[i];
@@ -1288,6 +1774,7 @@ void WS2812FX::setMode(uint8_t segid, uint8_t m) {
   if (_segments[segid].mode != m) {
     _segments[segid].startTransition(_transitionDur); // set effect transitions
     //_segments[segid].markForReset();
+    if (_segments[segid].isCrossfading()) _segments[segid].markForReset();
     _segments[segid].mode = m;
   }
 }
@@ -16,6 +16,7 @@ void colorRGBtoRGBW(byte* rgb);
 
 //udp.cpp
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, byte *buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcastSync(uint8_t type, IPAddress client);
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
@@ -407,6 +408,7 @@ BusNetwork::BusNetwork(BusConfig &bc) : Bus(bc.type, bc.start, bc.autoWhite) {
   _len = bc.count;
   _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
   _broadcastLock = false;
+  _sent = false;
   _valid = true;
 }
 
@@ -428,12 +430,19 @@ uint32_t BusNetwork::getPixelColor(uint16_t pix) {
 }
 
 void BusNetwork::show() {
+  _sent = false;
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, _rgbw);
+  _sent = realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, _rgbw) == 0;
   _broadcastLock = false;
 }
 
+void BusNetwork::sync() {
+  if (!_valid || !_sent) return; // no sync for a frame that was skipped or not sent
+  _sent = false;
+  realtimeBroadcastSync(_UDPtype, _client); // no-op unless sync output is enabled
+}
+
 uint8_t BusNetwork::getPins(uint8_t* pinArray) {
   for (uint8_t i = 0; i < 4; i++) {
     pinArray[i] = _client[i];
@@ -498,6 +507,10 @@ void BusManager::show() {
   for (uint8_t i = 0; i < numBusses; i++) {
     busses[i]->show();
   }
+  // sync after all data went out so that all network receivers present the frame simultaneously
+  for (uint8_t i = 0; i < numBusses; i++) {
+    busses[i]->sync();
+  }
 }
 
 void BusManager::setStatusPixel(uint32_t c) {
@@ -515,6 +528,18 @@ void IRAM_ATTR BusManager::setPixelColor(uint16_t pix, uint32_t c, int16_t cct)
   }
 }
 
+void IRAM_ATTR BusManager::setPixelColors(uint16_t pix, const uint32_t *c, uint16_t len) {
+  const uint32_t end = pix + len;
+  for (uint8_t i = 0; i < numBusses; i++) {
+    Bus* b = busses[i];
+    uint32_t bstart = b->getStart();
+    uint32_t bend   = bstart + b->getLength();
+    uint32_t from   = bstart > pix ? bstart : pix;
+    uint32_t to     = bend < end ? bend : end;
+    for (uint32_t p = from; p < to; p++) b->setPixelColor(p - bstart, c[p - pix]);
+  }
+}
+
 void BusManager::setBrightness(uint8_t b) {
   for (uint8_t i = 0; i < numBusses; i++) {
     busses[i]->setBrightness(b);
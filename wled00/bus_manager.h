@@ -104,6 +104,7 @@ class Bus {
     virtual ~Bus() {} //throw the bus under the bus
 
     virtual void     show() = 0;
+    virtual void     sync() {}  // frame complete on all busses (network busses send ArtSync/E1.31 sync/DDP push)
     virtual bool     canShow() { return true; }
     virtual void     setStatusPixel(uint32_t c) {}
     virtual void     setPixelColor(uint16_t pix, uint32_t c) = 0;
@@ -300,6 +301,8 @@ class BusNetwork : public Bus {
 
     void show();
 
+    void sync();
+
     bool canShow() {
       // this should be a return value from UDP routine if it is still sending data out
       return !_broadcastLock;
@@ -323,6 +326,7 @@ class BusNetwork : public Bus {
     uint8_t   _UDPchannels;
     bool      _rgbw;
     bool      _broadcastLock;
+    bool      _sent;          // frame went out in the last show(), sync() is due
     byte     *_data;
 };
 
@@ -344,6 +348,7 @@ class BusManager {
     void setStatusPixel(uint32_t c);
 
     void setPixelColor(uint16_t pix, uint32_t c, int16_t cct=-1);
+    void setPixelColors(uint16_t pix, const uint32_t *c, uint16_t len); // span of consecutive pixels, bus lookup once per bus
 
     void setBrightness(uint8_t b);
 
@@ -288,7 +288,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   }
 
   CJSON(serialBaud, hw[F("baud")]);
-  if (serialBaud < 96 || serialBaud > 15000) serialBaud = 1152;
+  if (serialBaud < 96 || serialBaud > 30000) serialBaud = 1152;
   updateBaudRate(serialBaud *100);
 
   JsonArray hw_if_i2c = hw[F("if")][F("i2c-pin")];
@@ -350,6 +350,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   int tdd = light_tr["dur"] | -1;
   if (tdd >= 0) transitionDelay = transitionDelayDefault = tdd * 100;
   CJSON(strip.paletteFade, light_tr["pal"]);
+  bool crossfade = strip.crossfadeEffects;
+  CJSON(strip.crossfadeEffects, light_tr["fx"]);
+  if (crossfade != strip.crossfadeEffects) doAllocCrossfade = true; // pool is (re)allocated in loop
   CJSON(randomPaletteChangeTime, light_tr[F("rpc")]);
 
   JsonObject light_nl = light["nl"];
@@ -404,6 +407,24 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(e131Port, if_live["port"]); // 5568
   if (e131Port == DDP_DEFAULT_PORT) e131Port = E131_DEFAULT_PORT; // prevent double DDP port allocation
   CJSON(e131Multicast, if_live[F("mc")]);
+  CJSON(realtimeHoldForSync, if_live[F("synchold")]);
+  CJSON(realtimeSyncTimeout, if_live[F("synctmo")]);
+  if (realtimeSyncTimeout < 20) realtimeSyncTimeout = 20;
+  CJSON(realtimeSyncOut, if_live[F("syncout")]);
+  CJSON(udpRxBudget, if_live[F("rxbudget")]);
+  if (!udpRxBudget) udpRxBudget = 1;
+  CJSON(realtimeRxQueue, if_live[F("rxq")]);
+  #ifdef ESP8266
+  if (realtimeRxQueue > 8) realtimeRxQueue = 8;
+  #else
+  if (realtimeRxQueue > 32) realtimeRxQueue = 32;
+  #endif
+
+  JsonObject if_live_jitter = if_live[F("jitter")];
+  CJSON(realtimeJitterFrames, if_live_jitter[F("frames")]);
+  if (realtimeJitterFrames > 8) realtimeJitterFrames = 8;
+  CJSON(realtimeJitterLatency, if_live_jitter[F("lat")]);
+  CJSON(realtimeJitterInterp, if_live_jitter[F("interp")]);
 
   JsonObject if_live_dmx = if_live[F("dmx")];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
@@ -415,6 +436,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(e131Priority, if_live_dmx[F("e131prio")]);
   if (e131Priority > 200) e131Priority = 200;
   CJSON(DMXMode, if_live_dmx["mode"]);
+  CJSON(e131FrameDeadline, if_live_dmx[F("framedl")]);
+  if (e131FrameDeadline < 5) e131FrameDeadline = 5;
 
   tdd = if_live[F("timeout")] | -1;
   if (tdd >= 0) realtimeTimeoutMs = tdd * 100;
@@ -812,6 +835,7 @@ void serializeConfig() {
   light_tr["mode"] = fadeTransition;
   light_tr["dur"] = transitionDelayDefault / 100;
   light_tr["pal"] = strip.paletteFade;
+  light_tr["fx"] = strip.crossfadeEffects;
   light_tr[F("rpc")] = randomPaletteChangeTime;
 
   JsonObject light_nl = light.createNestedObject("nl");
@@ -857,6 +881,16 @@ void serializeConfig() {
   if_live[F("mso")] = useMainSegmentOnly;
   if_live["port"] = e131Port;
   if_live[F("mc")] = e131Multicast;
+  if_live[F("synchold")] = realtimeHoldForSync;
+  if_live[F("synctmo")] = realtimeSyncTimeout;
+  if_live[F("syncout")] = realtimeSyncOut;
+  if_live[F("rxbudget")] = udpRxBudget;
+  if_live[F("rxq")] = realtimeRxQueue;
+
+  JsonObject if_live_jitter = if_live.createNestedObject(F("jitter"));
+  if_live_jitter[F("frames")] = realtimeJitterFrames;
+  if_live_jitter[F("lat")] = realtimeJitterLatency;
+  if_live_jitter[F("interp")] = realtimeJitterInterp;
 
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
@@ -865,6 +899,7 @@ void serializeConfig() {
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
   if_live_dmx["mode"] = DMXMode;
+  if_live_dmx[F("framedl")] = e131FrameDeadline;
 
   if_live[F("timeout")] = realtimeTimeoutMs / 100;
   if_live[F("maxbri")] = arlsForceMaxBri;
@@ -178,6 +178,19 @@
 #define REALTIME_MODE_TPM2NET     7
 #define REALTIME_MODE_DDP         8
 
+//realtime sources a segment can be bound to (segment "rt" object)
+#define LIVE_SRC_NONE             0
+#define LIVE_SRC_UNIVERSE         1    // E1.31/Art-Net universes starting at rt.start
+#define LIVE_SRC_DDP              2    // DDP pixels starting at rt.start
+
+//channel layouts of segment bound realtime data
+#define LIVE_LAYOUT_RGB           0
+#define LIVE_LAYOUT_GRB           1
+#define LIVE_LAYOUT_BGR           2
+#define LIVE_LAYOUT_RGBW          3
+#define LIVE_LAYOUT_GRBW          4
+#define LIVE_LAYOUT_COUNT         5
+
 //realtime override modes
 #define REALTIME_OVERRIDE_NONE    0
 #define REALTIME_OVERRIDE_ONCE    1
@@ -238,7 +251,7 @@
 #define TYPE_LPD6803             54
 //Network types (master broadcast) (80-95)
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 
@@ -394,6 +407,19 @@
 #define SETTINGS_STACK_BUF_SIZE 3096
 #endif
 
+// serial receive buffer for Adalight/TPM2, 256 bytes (default) last less than 3 ms at 921600 baud
+#ifndef WLED_SERIAL_RX_BUFFER
+  #ifdef ESP8266
+    #define WLED_SERIAL_RX_BUFFER 1024
+  #else
+    #define WLED_SERIAL_RX_BUFFER 4096
+  #endif
+#endif
+// serial transmit buffer for TPM2 output (ESP32 core 2.x, other cores write to the 128 byte UART FIFO only)
+#ifndef WLED_SERIAL_TX_BUFFER
+  #define WLED_SERIAL_TX_BUFFER 2048
+#endif
+
 #ifdef WLED_USE_ETHERNET
   #define E131_MAX_UNIVERSE_COUNT 20
 #else
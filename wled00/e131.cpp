@@ -8,6 +8,147 @@
  * E1.31 handler
  */
 
+/*
+ * Frame locked presentation: with realtimeHoldForSync the last complete frame is held (latched, see
+ * realtimeSyncLatch()) until ArtSync, an E1.31 synchronization packet or a DDP push arrives, so multiple
+ * controllers fed by the same source present their frames at the same time.
+ * If no sync arrives within realtimeSyncTimeout, data is shown free running until the next sync.
+ * E1.31 data with synchronization address 0 is not synchronized and shown as it arrives (E1.31: 6.2.4).
+ */
+static unsigned long syncHeldSince = 0;   // millis() when held data arrived, 0 if nothing is held
+static bool          syncLost = false;    // sync timed out, show data as it arrives
+static bool          syncShow = false;    // sync received, show held data without rate limiting
+static uint16_t      e131SyncAddress = 0; // synchronization universe announced by the E1.31 universes in use
+static bool          e131Unsynced = false; // last E1.31 universe in use has no synchronization address
+
+// realtime frame (or universe) received: show (rate limited) or hold until sync
+static void realtimeDataReady() {
+  if (!realtimeHoldForSync || syncLost || e131Unsynced) {
+    e131NewData = true;
+    return;
+  }
+  realtimeSyncLatch();
+  if (!syncHeldSince) syncHeldSince = millis() | 1;
+}
+
+// ArtSync, E1.31 sync or DDP push: present held data now
+static void realtimeSync() {
+  syncLost = false;
+  syncHeldSince = 0;
+  syncShow = true;
+  e131NewData = true;
+}
+
+/*
+ * Frame assembly for multi universe input: pixels of each universe are written as they arrive, but the
+ * frame is only shown once all universes covering the strip have been received, or e131FrameDeadline ms
+ * after it started (partial frame). Frames are keyed on the first universe (e131Universe): a new sequence
+ * number there starts the next frame. Sequence numbers count per universe, so other universes are only
+ * compared with their own previous packet:
+ * - a universe missing from a shown partial frame whose next packet directly follows its last one is that
+ *   frame's packet arriving late; it is counted, its data is kept but it does not count for the current frame
+ * - a universe arriving again in the same frame, or while no frame is open, belongs to the next frame
+ */
+static uint32_t      e131FrameMask = 0;     // universes received for the current frame (bit 0 = e131Universe), 0 = no frame open
+static uint32_t      e131FrameExpected = 0; // universes needed to cover all LEDs
+static uint32_t      e131EarlyMask = 0;     // universes received for the next frame
+static uint32_t      e131LateMask = 0;      // universes missing from the last partial frame
+static uint8_t       e131UniSeq[E131_MAX_UNIVERSE_COUNT] = {0}; // last sequence number per universe
+static unsigned long e131FrameStart = 0;
+
+static void e131FrameShow(bool complete) {
+  if (complete) {
+    e131FramesComplete++;
+  } else {
+    e131FramesPartial++;
+    e131LateMask = e131FrameExpected & ~e131FrameMask;
+  }
+  e131FrameMask = 0;
+  realtimeDataReady();
+}
+
+// book keeping for universe index (0 = e131Universe) of a frame spanning universes
+static void e131FrameUniverse(uint8_t index, uint8_t seq, uint8_t universes) {
+  const uint32_t bit = 1UL << index;
+  const int8_t advance = seq - e131UniSeq[index]; // packets since the last one of this universe
+  e131UniSeq[index] = seq;
+  e131FrameExpected = (1UL << universes) - 1;
+
+  if (index == 0) {
+    if (e131FrameMask && advance <= 0 && seq) return; // repeated or reordered, same frame (seq 0: Art-Net without sequencing)
+    if (e131FrameMask) e131FrameShow(false);          // next frame started before this one was complete
+    e131FrameMask = bit | e131EarlyMask;
+    e131EarlyMask = 0;
+    e131FrameStart = millis();
+    return;
+  }
+
+  if (advance <= 0 && seq) return; // repeated or reordered
+  if (e131LateMask & bit) {
+    e131LateMask &= ~bit;
+    if (advance == 1) { // packet of the partial frame already shown
+      e131LateUniverses++;
+      return;
+    }
+  }
+  if (!e131FrameMask || (e131FrameMask & bit)) e131EarlyMask |= bit; // ahead of the first universe
+  else                                         e131FrameMask |= bit;
+}
+
+// called from handleNotifications(), returns true if held data has to be shown immediately
+bool handleRealtimeSync() {
+  if (e131FrameMask && millis() - e131FrameStart > e131FrameDeadline) e131FrameShow(false);
+  if (syncHeldSince && millis() - syncHeldSince > realtimeSyncTimeout) {
+    DEBUG_PRINTLN(F("Realtime sync timeout, free running."));
+    syncHeldSince = 0;
+    syncLost = true;
+    e131NewData = true;
+  }
+  bool now = syncShow;
+  syncShow = false;
+  return now;
+}
+
+static bool rxFromQueue = false; // handling queued packets in the main loop, see handleRealtimeRx()
+
+// Realtime data bound to segments (Segment::liveSrc): universes or DDP pixels are written into the bound
+// segments only, without entering realtime mode, so other segments keep running their effects.
+// Segments are only written from the main loop (receive queue), a packet handled in the network context
+// before the queue is running is dropped.
+// Returns true if the data was consumed by a segment binding.
+static bool handleLiveUniverse(uint16_t uni, const uint8_t *data, uint16_t channels) {
+  bool consumed = false;
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+    Segment &seg = strip.getSegment(s);
+    if (seg.liveSrc != LIVE_SRC_UNIVERSE || !seg.isActive() || uni < seg.liveStart) continue;
+    const uint8_t bpp = seg.liveBytesPerPixel();
+    const uint16_t perUniverse = MAX_CHANNELS_PER_UNIVERSE / bpp; // 170 RGB or 128 RGBW pixels
+    const uint32_t first = (uint32_t)(uni - seg.liveStart) * perUniverse;
+    if (first >= seg.liveLength()) continue;
+    if (rxFromQueue) seg.setLivePixels(first, data, MIN(channels / bpp, perUniverse));
+    consumed = true;
+  }
+  return consumed;
+}
+
+static bool handleLiveDDP(uint32_t offset, const uint8_t *data, uint16_t len) {
+  bool bound = false;
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+    Segment &seg = strip.getSegment(s);
+    if (seg.liveSrc != LIVE_SRC_DDP || !seg.isActive()) continue;
+    bound = true; // DDP stream belongs to bound segments, even where this packet does not overlap
+    const uint8_t bpp = seg.liveBytesPerPixel();
+    const uint32_t segFirst = (uint32_t)seg.liveStart * bpp;  // first channel of the segment
+    const uint32_t segEnd   = segFirst + (uint32_t)seg.liveLength() * bpp;
+    uint32_t from = MAX(offset, segFirst);
+    const uint32_t to = MIN(offset + len, segEnd);
+    from += (bpp - (from - segFirst) % bpp) % bpp;               // skip pixel split across packets
+    if (from >= to) continue;
+    if (rxFromQueue) seg.setLivePixels((from - segFirst) / bpp, data + (from - offset), (to - from) / bpp);
+  }
+  return bound;
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
@@ -25,29 +166,39 @@ void handleDDPPacket(e131_packet_t* p) {
     }
   }
 
+  uint16_t c = 0;
+  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+
+  if (handleLiveDDP(htonl(p->channelOffset), &p->data[c], htons(p->dataLen))) {
+    if (p->flags & DDP_PUSH_FLAG) e131NewData = true;
+    return;
+  }
+
   uint8_t ddpChannelsPerLed = ((p->dataType & 0b00111000)>>3 == 0b011) ? 4 : 3; // data type 0x1B (formerly 0x1A) is RGBW (type 3, 8 bit/channel)
 
   uint32_t start =  htonl(p->channelOffset) / ddpChannelsPerLed;
   start += DMXAddress / ddpChannelsPerLed;
   uint16_t stop = start + htons(p->dataLen) / ddpChannelsPerLed;
   uint8_t* data = p->data;
-  uint16_t c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
 
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride || (realtimeMode && useMainSegmentOnly)) {
-    for (uint16_t i = start; i < stop; i++) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-      c += ddpChannelsPerLed;
-    }
+  if ((!realtimeOverride || (realtimeMode && useMainSegmentOnly)) && stop > start) {
+    setRealtimePixels(start, &data[c], stop - start, ddpChannelsPerLed);
   }
 
   bool push = p->flags & DDP_PUSH_FLAG;
   if (push) {
-    e131NewData = true;
+    if (realtimeHoldForSync) {
+      realtimeSyncLatch(); // the push completes the frame
+      realtimeSync();
+    } else {
+      e131NewData = true;
+    }
     byte sn = p->sequenceNum & 0xF;
     if (sn) e131LastSequenceNumber[0] = sn;
+  } else if (realtimeHoldForSync) {
+    realtimeDataReady(); // held until push (or sync timeout)
   }
 }
 
@@ -57,6 +208,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   uint16_t uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
   uint8_t seq = 0, mde = REALTIME_MODE_E131;
+  uint16_t syncAddr = 0;
 
   if (protocol == P_ARTNET)
   {
@@ -64,18 +216,28 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      if (realtimeHoldForSync) realtimeSync();
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) { // synchronization packet
+      uint16_t syncAddr = (p->raw[E131_SYNC_ADDR] << 8) | p->raw[E131_SYNC_ADDR+1];
+      if (realtimeHoldForSync && (!e131SyncAddress || syncAddr == e131SyncAddress)) realtimeSync();
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
     // DMX level data is zero start code. Ignore everything else. (E1.11: 8.5)
     if (dmxChannels == 0 || p->property_values[0] != 0) return;
     uni = htons(p->universe);
+    syncAddr = htons(p->reserved); // synchronization address (E1.31: 6.2.4), 0 = not synchronized
     e131_data = p->property_values;
     seq = p->sequence_number;
     if (e131Priority != 0) {
@@ -86,6 +248,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     }
   } else { //DDP
     realtimeIP = clientIP;
+    e131Unsynced = false;
     handleDDPPacket(p);
     return;
   }
@@ -99,9 +262,19 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   }
   #endif
 
+  // universes bound to segments
+  if (handleLiveUniverse(uni, e131_data + (protocol == P_ARTNET ? 0 : 1), dmxChannels)) {
+    realtimeIP = clientIP;
+    e131NewData = true;
+    return;
+  }
+
   // only listen for universes we're handling & allocated memory
   if (uni < e131Universe || uni >= (e131Universe + E131_MAX_UNIVERSE_COUNT)) return;
 
+  if (syncAddr) e131SyncAddress = syncAddr;
+  e131Unsynced = (protocol == P_E131 && !syncAddr);
+
   uint8_t previousUniverses = uni - e131Universe;
 
   if (e131SkipOutOfSequence)
@@ -268,6 +441,8 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
         const uint16_t ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
         uint8_t stripBrightness = bri;
         uint16_t previousLeds, dmxOffset, ledsTotal;
+        const uint16_t dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+        const uint16_t ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
 
         if (previousUniverses == 0) {
           if (availDMXLen < 1) return;
@@ -283,8 +458,6 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
         } else {
           // All subsequent universes start at the first channel.
           dmxOffset = (protocol == P_ARTNET) ? 0 : 1;
-          const uint16_t dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-          uint16_t ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
           previousLeds = ledsInFirstUniverse + (previousUniverses - 1) * ledsPerUniverse;
           ledsTotal = previousLeds + (dmxChannels / dmxChannelsPerLed);
         }
@@ -308,18 +481,15 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
           }
         }
 
-        if (!is4Chan) {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], 0);
-            dmxOffset+=3;
-          }
-        } else {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], e131_data[dmxOffset+3]);
-            dmxOffset+=4;
-          }
-        }
-        break;
+        // number of universes covering all LEDs
+        uint16_t universes = 1;
+        if (totalLen > ledsInFirstUniverse) universes += (totalLen - ledsInFirstUniverse + ledsPerUniverse - 1) / ledsPerUniverse;
+        if (universes > E131_MAX_UNIVERSE_COUNT) universes = E131_MAX_UNIVERSE_COUNT;
+        e131FrameUniverse(previousUniverses, seq, universes);
+
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, &e131_data[dmxOffset], ledsTotal - previousLeds, is4Chan ? 4 : 3);
+        if (e131FrameMask == e131FrameExpected) e131FrameShow(true);
+        return; // shown when the frame is complete (or its deadline expired)
       }
     default:
       DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
@@ -327,7 +497,83 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       break;
   }
 
-  e131NewData = true;
+  realtimeDataReady();
+}
+
+/*
+ * Receive queue: with realtimeRxQueue set, valid E1.31/Art-Net/DDP packets are only copied into a lock-free
+ * ring in the network context (AsyncUDP task on ESP32, SYS on ESP8266, the single producer for both ports)
+ * and handled in the main loop, so the network stack is not blocked by pixel processing and keeps
+ * receiving while a long show() is in progress. A full ring drops new packets.
+ * Each slot holds a whole packet (sizeof(e131_packet_t) + 8 = 1466 bytes, slot count rounded down to a power
+ * of two): 8 slots take 11.7 kB of heap, 32 slots 46.9 kB. The ring is allocated on first use and never
+ * freed, a changed size applies after reboot.
+ * Segment bound data (Segment::liveSrc) is always queued, segments must not be written from the network
+ * context while the main loop renders them: with realtimeRxQueue 0, a ring of RX_QUEUE_LIVE slots is
+ * allocated once a segment is bound and packets are queued while any segment is.
+ */
+#define RX_QUEUE_META 8 // client IP, protocol, padding
+#define RX_QUEUE_SLOT (RX_QUEUE_META + sizeof(e131_packet_t))
+#define RX_QUEUE_LIVE 8 // slots for segment bound data with realtimeRxQueue 0
+
+static SpscRing rxQueue;
+static volatile bool rxQueueOn = false; // set by the main loop, read by the network context
+static bool rxQueueFailed = false;
+
+static bool hasLiveSegments() {
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+    Segment &seg = strip.getSegment(s);
+    if (seg.liveSrc != LIVE_SRC_NONE && seg.isActive()) return true;
+  }
+  return false;
+}
+
+// network context
+static bool queueE131Packet(const uint8_t* data, size_t len, IPAddress clientIP, byte protocol) {
+  if (!rxQueueOn) return false; // handle in place
+  uint8_t *slot = rxQueue.acquire();
+  if (!slot) return true; // full, dropped
+  if (len > sizeof(e131_packet_t)) len = sizeof(e131_packet_t);
+  uint32_t ip = clientIP;
+  memcpy(slot, &ip, 4);
+  slot[4] = protocol;
+  memcpy(slot + RX_QUEUE_META, data, len);
+  rxQueue.publish(len);
+  return true;
+}
+
+// called from handleNotifications(), handles packets queued so far
+void handleRealtimeRx() {
+  const bool live = hasLiveSegments();
+  if (!rxQueue.isActive()) {
+    if ((!realtimeRxQueue && !live) || rxQueueFailed) return;
+    if (!rxQueue.begin(realtimeRxQueue ? realtimeRxQueue : RX_QUEUE_LIVE, RX_QUEUE_SLOT)) {
+      DEBUG_PRINTLN(F("Realtime receive queue allocation failed."));
+      realtimeRxQueue = 0;
+      rxQueueFailed = true;
+      return;
+    }
+    e131.setQueue(queueE131Packet);
+    ddp.setQueue(queueE131Packet);
+  }
+  rxQueueOn = realtimeRxQueue || live;
+
+  uint16_t queued = rxQueue.getQueued();
+  if (queued > realtimeRxQueuePeak) realtimeRxQueuePeak = queued;
+  realtimeRxQueueDropped = rxQueue.getDropped();
+  // only packets queued on entry, so a steady stream cannot keep the loop here
+  for (; queued; queued--) {
+    uint16_t len;
+    const uint8_t *slot = rxQueue.peek(len);
+    if (!slot) break;
+    uint32_t ip;
+    memcpy(&ip, slot, 4);
+    // the tail of a short packet may hold stale data, as the network buffer would
+    rxFromQueue = true;
+    handleE131Packet((e131_packet_t*)(slot + RX_QUEUE_META), IPAddress(ip), slot[4]);
+    rxFromQueue = false;
+    rxQueue.pop();
+  }
 }
 
 void handleArtnetPollReply(IPAddress ipAddress) {
@@ -85,6 +85,8 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
 void handleArtnetPollReply(IPAddress ipAddress);
 void prepareArtnetPollReply(ArtPollReply* reply);
 void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress);
+bool handleRealtimeSync();
+void handleRealtimeRx();
 
 //file.cpp
 bool handleFileRead(AsyncWebServerRequest*, String path);
@@ -214,10 +216,16 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcastSync(uint8_t type, IPAddress client);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(uint16_t i, const byte *data, uint16_t count, uint8_t bpp = 3);
+void setRealtimeColors(uint16_t i, const uint32_t *c, uint16_t count);
+void realtimeShow();
+void realtimeSyncLatch();
+void realtimeSyncShow();
 void refreshNodeList();
 void sendSysInfoUDP();
 
@@ -349,6 +357,10 @@ void clearEEPROM();
 #endif
 
 //wled_math.cpp
+int16_t sin16_t(uint16_t angle);
+int16_t cos16_t(uint16_t angle);
+uint16_t atan2_16_t(int32_t y, int32_t x);
+uint16_t sqrt32_t(uint32_t x);
 #ifndef WLED_USE_REAL_MATH
   template <typename T> T atan_t(T x);
   float cos_t(float phi);
@@ -356,6 +368,8 @@ void clearEEPROM();
   float tan_t(float x);
   float acos_t(float x);
   float asin_t(float x);
+  float atan2_t(float y, float x);
+  float sqrt_t(float x);
   float floor_t(float x);
   float fmod_t(float num, float denom);
 #else
@@ -366,6 +380,8 @@ void clearEEPROM();
   #define asin_t asin
   #define acos_t acos
   #define atan_t atan
+  #define atan2_t atan2
+  #define sqrt_t sqrt
   #define fmod_t fmod
   #define floor_t floor
 #endif
@@ -373,6 +389,7 @@ void clearEEPROM();
 //wled_serial.cpp
 void handleSerial();
 void updateBaudRate(uint32_t rate);
+void finishSerialOutput();
 
 //wled_server.cpp
 bool isIp(String str);
@@ -132,6 +132,7 @@ void handleImprovPacket() {
 }
 
 void sendImprovStateResponse(uint8_t state, bool error) {
+  finishSerialOutput();
   if (!error && improvError > 0 && improvError < 3) sendImprovStateResponse(0x00, true);
   if (error) improvError = state;
   char out[11] = {'I','M','P','R','O','V'};
@@ -148,6 +149,7 @@ void sendImprovStateResponse(uint8_t state, bool error) {
 }
 
 void sendImprovRPCResponse(byte commandId) {
+  finishSerialOutput();
   if (improvError > 0 && improvError < 3) sendImprovStateResponse(0x00, true);
   uint8_t packetLen = 12;
   char out[64] = {'I','M','P','R','O','V'};
@@ -178,6 +180,7 @@ void sendImprovRPCResponse(byte commandId) {
 }
 
 void sendImprovInfoResponse() {
+  finishSerialOutput();
   if (improvError > 0 && improvError < 3) sendImprovStateResponse(0x00, true);
   uint8_t packetLen = 12;
   char out[128] = {'I','M','P','R','O','V'};
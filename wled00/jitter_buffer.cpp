@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jitter_buffer.h"
+
+/*
+ * Jitter buffer for realtime frames, see jitter_buffer.h
+ * Intervals, jitter and latency are smoothed with a 1/16 EWMA and kept in Q4 (1/16 ms).
+ */
+
+#define JB_MAX_FRAMES 8
+#define JB_MAX_GAP    1000 // ms between frames after which the stream is considered restarted
+#define JB_WARMUP     16   // intervals averaged over the whole stream before switching to the EWMA
+
+bool JitterBuffer::allocate(uint8_t frames, uint16_t len) {
+  if (frames < 1) frames = 1;
+  if (frames > JB_MAX_FRAMES) frames = JB_MAX_FRAMES;
+  if (_data && frames == _frames && len == _len) return true;
+  release();
+  if (!len) return false;
+  // queue slots + last presented, write frame, blend frame
+  _data = (uint32_t*)malloc(((size_t)frames + 3) * len * sizeof(uint32_t));
+  _stamp = (uint32_t*)malloc(((size_t)frames + 1) * sizeof(uint32_t));
+  if (!_data || !_stamp) {
+    release();
+    return false;
+  }
+  _frames = frames;
+  _len    = len;
+  _write  = slot(frames + 1);
+  _blend  = _write + len;
+  memset(_write, 0, len * sizeof(uint32_t));
+  memset(&_stats, 0, sizeof(_stats));
+  reset();
+  return true;
+}
+
+void JitterBuffer::release() {
+  free(_data);
+  free(_stamp);
+  _data = _write = _blend = _stamp = nullptr;
+  _frames = 0;
+  _len = 0;
+  _count = 0;
+}
+
+void JitterBuffer::reset() {
+  _head = 0;
+  _count = 0;
+  _playing = false;
+  _isLate = false;
+  _blended = false;
+  _lastArrival = 0;
+  _samples = 0;
+  _interval = 0;
+  _jitter = 0;
+  _latency = 0;
+}
+
+void JitterBuffer::commit(uint32_t now) {
+  if (!_data) return;
+
+  // arrival interval and jitter (mean deviation from the smoothed interval, as in RFC 3550)
+  if (_stats.received) {
+    uint32_t delta = now - _lastArrival;
+    if (delta > JB_MAX_GAP) {
+      _samples = 0; // stream (re)started, estimate the cadence again
+      _interval = 0;
+      _jitter = 0;
+    } else if (_samples < JB_WARMUP) {
+      // mean interval since the stream started: bursts (several frames within one ms) average out
+      // right away instead of skewing the EWMA for its first few dozen frames
+      _samples++;
+      _interval = ((now - _firstArrival) << 4) / _samples;
+    } else {
+      int32_t d = (int32_t)(delta << 4) - (int32_t)_interval;
+      _interval += d / 16;
+      _jitter   += ((d < 0 ? -d : d) - (int32_t)_jitter) / 16;
+    }
+  }
+  if (!_samples) _firstArrival = now;
+  _lastArrival = now;
+  _stats.received++;
+
+  if (_count == _frames) { // full: drop the oldest frame
+    _head = next(_head);
+    _count--;
+    _stats.dropped++;
+  }
+  uint8_t tail = (_head + _count) % (_frames + 1);
+  memcpy(slot(tail), _write, _len * sizeof(uint32_t));
+  _stamp[tail] = now;
+  _count++;
+}
+
+const uint32_t *JitterBuffer::present(uint32_t now, uint16_t latency, bool interpolate) {
+  if (!_data) return nullptr;
+  const uint32_t interval = (_interval + 8) >> 4; // ms
+
+  if (!_playing) {
+    // start once the cadence is known and the oldest frame has been held for the target latency,
+    // or the buffer is full
+    if (!_count) return nullptr;
+    if ((!_interval || now - _stamp[_head] < latency) && _count < _frames) return nullptr;
+    _playing = true;
+    _nextDue = now;
+  }
+  if ((int32_t)(now - _nextDue) < 0) return nullptr;
+
+  if (!_count) { // frame is late: hold the last one and present the next as soon as it arrives
+    if (!_isLate) _stats.late++;
+    _isLate = true;
+    return nullptr;
+  }
+
+  if (_isLate && interpolate && !_blended && interval > 1) {
+    // ease the step after a late frame: 50% blend now, the frame itself half an interval later
+    const uint32_t *a = slot((_head + _frames) % (_frames + 1)); // last presented
+    const uint32_t *b = slot(_head);
+    for (size_t i = 0; i < _len; i++) _blend[i] = ((a[i] >> 1) & 0x7F7F7F7F) + ((b[i] >> 1) & 0x7F7F7F7F);
+    _blended = true;
+    _nextDue = now + interval / 2;
+    _stats.interpolated++;
+    return _blend;
+  }
+
+  const uint32_t *frame = slot(_head);
+  const uint32_t age = (now - _stamp[_head]) << 4;
+  if (!_stats.presented) _latency = age;
+  else                   _latency += ((int32_t)age - (int32_t)_latency) / 16;
+  _head = next(_head);
+  _count--;
+  _isLate = false;
+  _blended = false;
+  _stats.presented++;
+
+  // next due time: nominal cadence, 1/8 faster while the next frame is held longer than the target
+  // latency (buffer filling up), 1/8 slower while it is fresher than that (buffer running dry)
+  uint32_t step = interval;
+  if (_count) {
+    uint32_t nextAge = now - _stamp[_head] + interval; // at its due time
+    if (nextAge > latency + interval / 2 || _count == _frames) step -= step / 8;
+    else if (nextAge + interval / 2 < latency)             step += step / 8;
+  } else {
+    step += step / 8;
+  }
+  if ((int32_t)(now - _nextDue) > (int32_t)step) _nextDue = now + step; // fell behind, restart cadence
+  else                                           _nextDue += step;
+  return frame;
+}
+
+void JitterBuffer::getStats(Stats &s) const {
+  s = _stats;
+  s.interval = (_interval + 8) >> 4;
+  s.jitter   = (_jitter + 8) >> 4;
+  s.latency  = (_latency + 8) >> 4;
+  s.depth    = _count;
+}
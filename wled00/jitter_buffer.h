@@ -0,0 +1,73 @@
+#ifndef WLED_JITTER_BUFFER_H
+#define WLED_JITTER_BUFFER_H
+/*
+ * Jitter buffer for realtime frames received over Wi-Fi.
+ *
+ * Frames are timestamped when they are complete and presented at a smoothed cadence (the average
+ * arrival interval) about `latency` ms after their arrival, so bursts of frames caused by Wi-Fi
+ * aggregation do not show as stutter. When no frame is available at its due time the last one is held;
+ * with interpolation enabled the late frame is first shown blended 50% with the held one.
+ *
+ * Independent of Arduino APIs: time is passed in by the caller (milliseconds, wrapping), so the
+ * scheduling can be exercised on host by feeding synthetic arrival time traces to commit()/present().
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+class JitterBuffer {
+  public:
+    struct Stats {
+      uint32_t received;     // frames committed
+      uint32_t presented;    // frames presented
+      uint32_t dropped;      // frames discarded because the buffer was full
+      uint32_t late;         // due times without a frame to present (held last frame)
+      uint32_t interpolated; // blended frames shown after a late frame
+      uint16_t interval;     // smoothed arrival interval (ms)
+      uint16_t jitter;       // mean arrival interval deviation (ms)
+      uint16_t latency;      // smoothed arrival to presentation delay (ms)
+      uint8_t  depth;        // frames currently queued
+    };
+
+    JitterBuffer() {}
+    ~JitterBuffer() { release(); }
+
+    bool allocate(uint8_t frames, uint16_t len); // frames to queue (1-8), pixels per frame
+    void release();
+    void reset();                                // drop queued frames and restart cadence estimation
+
+    bool     isActive() const    { return _data != nullptr; }
+    uint8_t  getFrames() const   { return _frames; }
+    uint16_t getLength() const   { return _len; }
+    uint32_t *getWriteFrame()    { return _write; } // frame being filled by realtime ingest
+
+    void commit(uint32_t now);                                  // write frame is complete
+    const uint32_t *present(uint32_t now, uint16_t latency, bool interpolate); // frame to show now or nullptr
+
+    void getStats(Stats &s) const;
+
+  private:
+    uint32_t *slot(uint8_t i) const { return _data + (size_t)i * _len; }
+    uint8_t   next(uint8_t i) const { return (i + 1) % (_frames + 1); }
+
+    uint32_t *_data   = nullptr; // _frames+1 slots (queue + last presented), write frame, blend frame
+    uint32_t *_write  = nullptr;
+    uint32_t *_blend  = nullptr;
+    uint32_t *_stamp  = nullptr; // arrival time per slot
+    uint16_t  _len    = 0;
+    uint8_t   _frames = 0;
+    uint8_t   _head   = 0;       // next slot to present
+    uint8_t   _count  = 0;       // queued frames
+    bool      _playing = false;  // cadence established
+    bool      _isLate  = false;  // a due time passed without a frame
+    bool      _blended = false;  // blend for the late frame has been shown
+    uint32_t  _lastArrival = 0;
+    uint32_t  _firstArrival = 0; // start of cadence estimation
+    uint8_t   _samples = 0;      // intervals in the estimate so far (up to JB_WARMUP)
+    uint32_t  _nextDue = 0;
+    uint32_t  _interval = 0;     // Q4 ms
+    uint32_t  _jitter = 0;       // Q4 ms
+    uint32_t  _latency = 0;      // Q4 ms
+    Stats     _stats = {};
+};
+
+#endif
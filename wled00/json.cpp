@@ -224,6 +224,19 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
   seg.check2 = elem["o2"] | seg.check2;
   seg.check3 = elem["o3"] | seg.check3;
 
+  seg.keyframes = elem[F("kf")] | seg.keyframes; // effect keyframe rate (0 = render every frame)
+
+  // realtime source bound to this segment
+  JsonObject rt = elem[F("rt")];
+  if (!rt.isNull()) {
+    seg.liveSrc    = rt[F("src")] | seg.liveSrc;
+    seg.liveStart  = rt[F("start")] | seg.liveStart;
+    seg.liveLayout = rt[F("lay")] | seg.liveLayout;
+    seg.liveGamma  = rt[F("gc")] | seg.liveGamma;
+    if (seg.liveSrc > LIVE_SRC_DDP) seg.liveSrc = LIVE_SRC_NONE;
+    if (seg.liveLayout >= LIVE_LAYOUT_COUNT) seg.liveLayout = LIVE_LAYOUT_RGB;
+  }
+
   JsonArray iarr = elem[F("i")]; //set individual LEDs
   if (!iarr.isNull()) {
     uint8_t oldMap1D2D = seg.map1D2D;
@@ -525,6 +538,15 @@ void serializeSegment(JsonObject& root, Segment& seg, byte id, bool forPreset, b
   root["o3"]  = seg.check3;
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
+  root[F("kf")] = seg.keyframes;
+  if (seg.liveSrc != LIVE_SRC_NONE) {
+    JsonObject rt = root.createNestedObject(F("rt"));
+    rt[F("src")]   = seg.liveSrc;
+    rt[F("start")] = seg.liveStart;
+    rt[F("lay")]   = seg.liveLayout;
+    rt[F("gc")]    = seg.liveGamma;
+    if (!forPreset) rt[F("live")] = seg.isLive();
+  }
 }
 
 void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
@@ -597,6 +619,7 @@ void serializeInfo(JsonObject root)
   leds["fps"] = strip.getFps();
   leds[F("maxpwr")] = (strip.currentMilliamps)? strip.ablMilliampsMax : 0;
   leds[F("maxseg")] = strip.getMaxSegments();
+  leds[F("xfskip")] = strip.getSkippedCrossfades();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
   //leds[F("seglock")] = false; //might be used in the future to prevent modifications to segment config
 
@@ -660,6 +683,39 @@ void serializeInfo(JsonObject root)
     root[F("lip")] = realtimeIP.toString();
   }
 
+  JsonObject udp_info = root.createNestedObject(F("udprx"));
+  udp_info[F("pkts")]   = udpPacketsReceived;
+  udp_info[F("drop")]   = udpPacketsDropped;
+  udp_info[F("super")]  = udpFramesSuperseded; // realtime frames coalesced
+  udp_info[F("budget")] = udpRxBudgetExceeded; // passes ending with packets possibly left pending
+  udp_info[F("rxq")]    = realtimeRxQueue;     // E1.31/Art-Net/DDP receive queue slots
+  udp_info[F("qpeak")]  = realtimeRxQueuePeak;
+  udp_info[F("qdrop")]  = realtimeRxQueueDropped;
+
+  JsonObject dmx_info = root.createNestedObject(F("dmx"));
+  dmx_info[F("frames")]  = e131FramesComplete; // multi universe frames complete
+  dmx_info[F("partial")] = e131FramesPartial;  // shown on deadline or when the next frame started
+  dmx_info[F("late")]    = e131LateUniverses;  // universes arriving after their frame was shown
+
+  #ifdef WLED_ENABLE_ADALIGHT
+  root[F("sertxskip")] = serialFramesSkipped;
+  #endif
+
+  if (realtimeJitter.isActive()) {
+    JitterBuffer::Stats jbs;
+    realtimeJitter.getStats(jbs);
+    JsonObject jitter_info = root.createNestedObject(F("jitter"));
+    jitter_info[F("rx")]     = jbs.received;
+    jitter_info[F("shown")]  = jbs.presented;
+    jitter_info[F("drop")]   = jbs.dropped;
+    jitter_info[F("late")]   = jbs.late;
+    jitter_info[F("interp")] = jbs.interpolated;
+    jitter_info[F("int")]    = jbs.interval; // ms between frames
+    jitter_info[F("jit")]    = jbs.jitter;   // ms mean deviation
+    jitter_info[F("lat")]    = jbs.latency;  // ms arrival to presentation
+    jitter_info[F("depth")]  = jbs.depth;
+  }
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -0,0 +1,225 @@
+#include <stdlib.h>
+#include <string.h>
+#include "net_out.h"
+#include "src/dependencies/e131/E131Packet.h"
+
+/*
+ * Network bus output packets, see net_out.h
+ */
+
+#define DDP_FLAGS1_VER 0xc0  // version mask
+#define DDP_FLAGS1_VER1 0x40 // version=1
+#define DDP_FLAGS1_PUSH 0x01
+#define DDP_FLAGS1_QUERY 0x02
+#define DDP_FLAGS1_REPLY 0x04
+#define DDP_FLAGS1_STORAGE 0x08
+#define DDP_FLAGS1_TIME 0x10
+
+#define DDP_ID_DISPLAY 1
+#define DDP_ID_CONFIG 250
+#define DDP_ID_STATUS 251
+
+// 1440 channels per packet
+#define DDP_CHANNELS_PER_PACKET 1440 // 480 leds
+
+static const size_t  ART_NET_HEADER_SIZE = 12;
+static const uint8_t ART_NET_HEADER[] = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static const size_t  ART_NET_PACKET_HEADER_SIZE = ART_NET_HEADER_SIZE + 6; // + sequence, physical, universe, length
+static const size_t  E131_HEADER_SIZE = E131_DMP_DATA + 1; // incl. DMX start code
+static const size_t  NET_OUT_BUFFER_SIZE = DDP_HEADER_SIZE + DDP_CHANNELS_PER_PACKET; // largest packet of all protocols
+
+static inline void netPut16(uint8_t *p, uint16_t v) { p[0] = v >> 8; p[1] = v & 0xFF; }
+
+// E1.31 root layer preamble, ACN packet identifier and CID (fixed prefix + MAC, stable per device)
+static void e131OutRootLayer(uint8_t *p, const uint8_t *mac) {
+  netPut16(p + 0, 0x0010);                           // preamble size
+  memcpy(p + E131_ROOT_ID, E131_ACN_ID, sizeof(E131_ACN_ID));
+  memcpy(p + E131_ROOT_CID, "WLED-sACN-", 10);
+  memcpy(p + E131_ROOT_CID + 10, mac, 6);
+}
+
+// copies len channels into the packet payload, scaled by brightness through a LUT
+static void netOutPayload(uint8_t *dst, const uint8_t *src, size_t len, const uint8_t *lut) {
+  if (!lut) { memcpy(dst, src, len); return; }
+  for (size_t i = 0; i < len; i++) dst[i] = lut[src[i]];
+}
+
+NetOut::~NetOut() {
+  free(_buf);
+}
+
+uint8_t *NetOut::packet(const NetOutParams &par) {
+  if (!_buf) _buf = (uint8_t*)malloc(NET_OUT_BUFFER_SIZE);
+  if (!_buf || _type == par.type) return _buf;
+  uint8_t *p = _buf;
+  _type = par.type;
+  switch (par.type) {
+    case NETOUT_DDP: // flags, sequence, data type, id, offset (patched per packet)
+      memset(p, 0, DDP_HEADER_SIZE);
+      p[3] = DDP_ID_DISPLAY;
+      break;
+    case NETOUT_E131:
+    {
+      memset(p, 0, E131_HEADER_SIZE);
+      // root layer
+      e131OutRootLayer(p, par.mac);
+      p[E131_ROOT_VECTOR+3] = E131_VECTOR_ROOT_DATA;
+      // framing layer
+      p[E131_FRAME_VECTOR+3] = E131_VECTOR_DATA_PACKET;
+      strncpy((char*)p + E131_FRAME_SOURCE, par.source ? par.source : "", 63); // null terminated, rest zeroed
+      // DMP layer
+      p[E131_DMP_VECTOR] = E131_VECTOR_DMP_SET_PROPERTY;
+      p[E131_DMP_TYPE]   = 0xA1;                     // address & data type
+      netPut16(p + E131_DMP_ADDR_INC, 1);
+    } break;
+    case NETOUT_ARTNET: // hard coded ID, OpCode and protocol version
+      memcpy(p, ART_NET_HEADER, ART_NET_HEADER_SIZE);
+      memset(p + ART_NET_HEADER_SIZE, 0, ART_NET_PACKET_HEADER_SIZE - ART_NET_HEADER_SIZE);
+      break;
+  }
+  return p;
+}
+
+bool NetOut::frame(const NetOutParams &par, const uint8_t *buffer, uint16_t length, NetOutSendFn send, void *arg) {
+  if (par.type > NETOUT_ARTNET || !length) return false;
+  uint8_t *packet = this->packet(par);
+  if (!packet) return false;
+
+  const size_t channelCount = length * (par.rgbw?4:3); // 1 channel for every R,G,B,(W?) value
+  size_t bufferOffset = 0;
+
+  switch (par.type) {
+    case NETOUT_DDP:
+    {
+      // calculate the number of UDP packets we need to send
+      const size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
+      uint32_t channel = 0; // TODO: allow specifying the start channel
+
+      packet[2] = par.rgbw ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+        if (_sequence > 15) _sequence = 0;
+
+        // the amount of data is AFTER the header in the current packet
+        size_t packetSize = DDP_CHANNELS_PER_PACKET;
+        uint8_t flags = DDP_FLAGS1_VER1;
+        if (currentPacket == (packetCount - 1U)) {
+          // last packet, set the push flag (unless a separate push is sent to all outputs by sync())
+          if (!par.syncOut) flags = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
+          if (channelCount % DDP_CHANNELS_PER_PACKET) {
+            packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
+          }
+        }
+
+        packet[0] = flags;
+        packet[1] = _sequence++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
+        // data offset in bytes, 32-bit number, MSB first
+        packet[4] = 0xFF & (channel >> 24);
+        packet[5] = 0xFF & (channel >> 16);
+        packet[6] = 0xFF & (channel >>  8);
+        packet[7] = 0xFF & (channel      );
+        // data length in bytes, 16-bit number, MSB first
+        netPut16(packet + 8, packetSize);
+
+        netOutPayload(packet + DDP_HEADER_SIZE, buffer + bufferOffset, packetSize, par.lut);
+        bufferOffset += packetSize;
+        if (!send(DDP_DEFAULT_PORT, packet, DDP_HEADER_SIZE + packetSize, arg)) return false; // problem
+
+        channel += packetSize;
+      }
+    } break;
+
+    case NETOUT_E131:
+    {
+      const size_t E131_CHANNELS_PER_PACKET = par.rgbw?512:510; // whole pixels per universe: 128 RGBW or 170 RGB
+      const size_t packetCount = ((channelCount-1)/E131_CHANNELS_PER_PACKET)+1;
+
+      packet[E131_FRAME_PRIORITY] = par.priority ? par.priority : 100; // 100 is the sACN default priority
+      packet[E131_FRAME_SEQ]      = ++_e131Seq;          // one sequence number per frame, shared by all universes
+      netPut16(packet + E131_FRAME_RESERVED, par.syncOut ? NETOUT_E131_SYNC_UNIVERSE : 0); // receivers hold data until sync
+
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+        size_t packetSize = E131_CHANNELS_PER_PACKET;
+        if (currentPacket == (packetCount - 1U) && (channelCount % E131_CHANNELS_PER_PACKET)) {
+          packetSize = channelCount % E131_CHANNELS_PER_PACKET; // last packet
+        }
+        const size_t totalSize = E131_HEADER_SIZE + packetSize;
+
+        // patch lengths (flags 0x7 in the high nibble) and universe, universes start at 1
+        netPut16(packet + E131_ROOT_FLENGTH,  0x7000 | (totalSize - E131_ROOT_FLENGTH));
+        netPut16(packet + E131_FRAME_FLENGTH, 0x7000 | (totalSize - E131_FRAME_FLENGTH));
+        netPut16(packet + E131_DMP_FLENGTH,   0x7000 | (totalSize - E131_DMP_FLENGTH));
+        netPut16(packet + E131_FRAME_UNIVERSE, currentPacket + 1);
+        netPut16(packet + E131_DMP_COUNT, packetSize + 1); // incl. start code
+
+        netOutPayload(packet + E131_HEADER_SIZE, buffer + bufferOffset, packetSize, par.lut);
+        bufferOffset += packetSize;
+        if (!send(E131_DEFAULT_PORT, packet, totalSize, arg)) return false; // borked
+      }
+    } break;
+
+    case NETOUT_ARTNET:
+    {
+      // calculate the number of UDP packets we need to send
+      const size_t ARTNET_CHANNELS_PER_PACKET = par.rgbw?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
+
+      _sequence++;
+
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+
+        if (_sequence > 255) _sequence = 0;
+
+        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
+
+        if (currentPacket == (packetCount - 1U)) {
+          // last packet
+          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
+            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
+          }
+        }
+
+        packet[ART_NET_HEADER_SIZE+0] = _sequence & 0xFF; // sequence number. 1..255
+        packet[ART_NET_HEADER_SIZE+1] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+        packet[ART_NET_HEADER_SIZE+2] = currentPacket & 0xFF; // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
+        packet[ART_NET_HEADER_SIZE+3] = 0x00; // Universe MSB, unused.
+        netPut16(packet + ART_NET_HEADER_SIZE + 4, packetSize); // 16-bit length of channel data, MSB first
+
+        netOutPayload(packet + ART_NET_PACKET_HEADER_SIZE, buffer + bufferOffset, packetSize, par.lut);
+        bufferOffset += packetSize;
+        if (!send(ARTNET_DEFAULT_PORT, packet, ART_NET_PACKET_HEADER_SIZE + packetSize, arg)) return false; // borked
+      }
+    } break;
+  }
+  return true;
+}
+
+// DDP push flag without data, E1.31 synchronization packet (E1.31: 6.3) or ArtSync
+bool NetOut::sync(const NetOutParams &par, NetOutSendFn send, void *arg) {
+  uint8_t packet[E131_SYNC_PACKET_SIZE];
+
+  switch (par.type) {
+    case NETOUT_DDP:
+      memset(packet, 0, DDP_HEADER_SIZE);
+      packet[0] = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
+      packet[3] = DDP_ID_DISPLAY;
+      return send(DDP_DEFAULT_PORT, packet, DDP_HEADER_SIZE, arg);
+
+    case NETOUT_E131:
+      memset(packet, 0, E131_SYNC_PACKET_SIZE);
+      e131OutRootLayer(packet, par.mac);
+      netPut16(packet + E131_ROOT_FLENGTH,  0x7000 | (E131_SYNC_PACKET_SIZE - E131_ROOT_FLENGTH));
+      packet[E131_ROOT_VECTOR+3] = E131_VECTOR_ROOT_EXTENDED;
+      netPut16(packet + E131_FRAME_FLENGTH, 0x7000 | (E131_SYNC_PACKET_SIZE - E131_FRAME_FLENGTH));
+      packet[E131_FRAME_VECTOR+3] = E131_VECTOR_EXTENDED_SYNC;
+      packet[E131_SYNC_SEQ] = _e131Seq;
+      netPut16(packet + E131_SYNC_ADDR, NETOUT_E131_SYNC_UNIVERSE);
+      return send(E131_DEFAULT_PORT, packet, E131_SYNC_PACKET_SIZE, arg);
+
+    case NETOUT_ARTNET: // ArtNet header with OpSync, aux fields 0
+      memcpy(packet, ART_NET_HEADER, ART_NET_HEADER_SIZE);
+      packet[9] = ARTNET_OPCODE_OPSYNC >> 8;
+      packet[12] = packet[13] = 0;
+      return send(ARTNET_DEFAULT_PORT, packet, ART_NET_HEADER_SIZE + 2, arg);
+  }
+  return false;
+}
@@ -0,0 +1,56 @@
+#ifndef WLED_NET_OUT_H
+#define WLED_NET_OUT_H
+/*
+ * Packet builder for network bus output (DDP, E1.31, Art-Net) and frame syncs (DDP push,
+ * E1.31 synchronization, ArtSync).
+ *
+ * Packets are assembled in one buffer which is allocated on first use and reused for every packet.
+ * The static part of a protocol header is written only when the protocol changes, per packet only
+ * sequence, offset/universe and lengths are patched, the payload is brightness scaled straight into
+ * the buffer and every complete packet is handed to a send callback for a single write.
+ *
+ * Plain C++ without Arduino dependencies (the caller sends, builds the brightness LUT and supplies
+ * device identity), so packets can be checked byte by byte on host.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#define NETOUT_DDP    0
+#define NETOUT_E131   1
+#define NETOUT_ARTNET 2
+
+#define NETOUT_E131_SYNC_UNIVERSE 63999 // synchronization address announced in E1.31 data packets
+
+// sends one packet to the bus client on the given UDP port, returns false on error
+typedef bool (*NetOutSendFn)(uint16_t port, const uint8_t *packet, size_t size, void *arg);
+
+struct NetOutParams {
+  uint8_t        type;     // NETOUT_DDP, NETOUT_E131 or NETOUT_ARTNET
+  bool           rgbw;     // 4 channels per pixel
+  bool           syncOut;  // frames are presented by a separate sync (no DDP push, E1.31 sync address set)
+  uint8_t        priority; // E1.31 priority, 0 = sACN default (100)
+  const char    *source;   // E1.31 source name
+  const uint8_t *mac;      // 6 bytes, for the E1.31 CID
+  const uint8_t *lut;      // 256 entry brightness LUT or nullptr for full brightness
+};
+
+class NetOut {
+  public:
+    NetOut() {}
+    ~NetOut();
+
+    // sends length pixels (3 or 4 channels each) from buffer, returns false on error
+    bool frame(const NetOutParams &p, const uint8_t *buffer, uint16_t length, NetOutSendFn send, void *arg);
+    // sends the sync for the last frame, returns false on error
+    bool sync(const NetOutParams &p, NetOutSendFn send, void *arg);
+
+  private:
+    uint8_t *packet(const NetOutParams &p);
+
+    uint8_t *_buf = nullptr;
+    uint8_t  _type = 255;      // protocol of the header currently held in _buf
+    uint32_t _sequence = 0;    // DDP and Art-Net, shared across all outputs
+    uint8_t  _e131Seq = 0;     // one sequence number per frame
+};
+
+#endif
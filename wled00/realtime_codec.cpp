@@ -0,0 +1,207 @@
+#include <stdlib.h>
+#include "realtime_codec.h"
+
+/*
+ * Compressed realtime UDP protocol, see realtime_codec.h
+ */
+
+#define RTZ_R(c) (((c) >> 16) & 0xFF)
+#define RTZ_G(c) (((c) >>  8) & 0xFF)
+#define RTZ_B(c) ( (c)        & 0xFF)
+#define RTZ_W(c) ( (c) >> 24)
+#define RTZ_RGBW32(r,g,b,w) ((uint32_t(w) << 24) | (uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b))
+
+uint8_t rtzColorSize(uint8_t flags) {
+  switch ((flags & RTZ_DEPTH_MASK) >> RTZ_DEPTH_SHIFT) {
+    case RTZ_DEPTH_8:    return (flags & RTZ_FLAG_RGBW) ? 4 : 3;
+    case RTZ_DEPTH_16:   return 2;
+    case RTZ_DEPTH_8BPP: return 1;
+  }
+  return 0; // reserved
+}
+
+static void rtzEncodeColor(uint8_t *p, uint32_t c, uint8_t flags) {
+  const bool rgbw = flags & RTZ_FLAG_RGBW;
+  uint16_t v;
+  switch ((flags & RTZ_DEPTH_MASK) >> RTZ_DEPTH_SHIFT) {
+    case RTZ_DEPTH_8:
+      p[0] = RTZ_R(c); p[1] = RTZ_G(c); p[2] = RTZ_B(c);
+      if (rgbw) p[3] = RTZ_W(c);
+      break;
+    case RTZ_DEPTH_16:
+      if (rgbw) v = ((RTZ_R(c) >> 4) << 12) | ((RTZ_G(c) >> 4) << 8) | ((RTZ_B(c) >> 4) << 4) | (RTZ_W(c) >> 4);
+      else      v = ((RTZ_R(c) >> 3) << 11) | ((RTZ_G(c) >> 2) << 5) | (RTZ_B(c) >> 3);
+      p[0] = v >> 8; p[1] = v & 0xFF;
+      break;
+    case RTZ_DEPTH_8BPP:
+      if (rgbw) p[0] = ((RTZ_R(c) >> 6) << 6) | ((RTZ_G(c) >> 6) << 4) | ((RTZ_B(c) >> 6) << 2) | (RTZ_W(c) >> 6);
+      else      p[0] = ((RTZ_R(c) >> 5) << 5) | ((RTZ_G(c) >> 5) << 2) | (RTZ_B(c) >> 6);
+      break;
+  }
+}
+
+// reduced depth channels are expanded by bit replication so full scale stays full scale
+static uint32_t rtzDecodeColor(const uint8_t *p, uint8_t flags) {
+  const bool rgbw = flags & RTZ_FLAG_RGBW;
+  switch ((flags & RTZ_DEPTH_MASK) >> RTZ_DEPTH_SHIFT) {
+    case RTZ_DEPTH_16: {
+      uint16_t v = (p[0] << 8) | p[1];
+      if (rgbw) return RTZ_RGBW32(((v >> 12) & 0xF) * 17, ((v >> 8) & 0xF) * 17, ((v >> 4) & 0xF) * 17, (v & 0xF) * 17);
+      uint8_t r = v >> 11, g = (v >> 5) & 0x3F, b = v & 0x1F;
+      return RTZ_RGBW32((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0);
+    }
+    case RTZ_DEPTH_8BPP: {
+      uint8_t v = p[0];
+      if (rgbw) return RTZ_RGBW32((v >> 6) * 85, ((v >> 4) & 3) * 85, ((v >> 2) & 3) * 85, (v & 3) * 85);
+      uint8_t r = v >> 5, g = (v >> 2) & 7;
+      return RTZ_RGBW32((r << 5) | (r << 2) | (r >> 1), (g << 5) | (g << 2) | (g >> 1), (v & 3) * 85, 0);
+    }
+    default:
+      return RTZ_RGBW32(p[0], p[1], p[2], rgbw ? p[3] : 0);
+  }
+}
+
+uint32_t rtzQuantize(uint32_t c, uint8_t flags) {
+  uint8_t b[4];
+  rtzEncodeColor(b, c, flags);
+  return rtzDecodeColor(b, flags);
+}
+
+int rtzDecode(const uint8_t *packet, size_t size, RtzSpanCallback cb, void *arg) {
+  if (size < RTZ_HEADER_SIZE || packet[0] != RTZ_PROTOCOL) return -1;
+  const uint8_t flags = packet[2];
+  const uint8_t cs = rtzColorSize(flags);
+  if (!cs) return -1;
+
+  // validate first so a truncated or corrupt packet is not applied partially
+  size_t pos = RTZ_HEADER_SIZE;
+  while (pos < size) {
+    uint8_t op = packet[pos++];
+    uint16_t n = (op & 0x3F) + 1;
+    switch (op & RTZ_OP_MASK) {
+      case RTZ_OP_SKIP:    break;
+      case RTZ_OP_RUN:     pos += cs; break;
+      case RTZ_OP_LITERAL: pos += n * cs; break;
+      default:             return -1;
+    }
+  }
+  if (pos != size) return -1;
+
+  uint32_t index = (packet[4] << 8) | packet[5];
+  uint32_t span[RTZ_OP_MAX_COUNT];
+  int written = 0;
+  pos = RTZ_HEADER_SIZE;
+  while (pos < size && index <= 0xFFFF) {
+    uint8_t op = packet[pos++];
+    uint16_t n = (op & 0x3F) + 1;
+    if (index + n > 0x10000) n = 0x10000 - index;
+    switch (op & RTZ_OP_MASK) {
+      case RTZ_OP_RUN: {
+        uint32_t c = rtzDecodeColor(packet + pos, flags);
+        pos += cs;
+        for (uint16_t j = 0; j < n; j++) span[j] = c;
+        cb(index, span, n, arg);
+        written += n;
+      } break;
+      case RTZ_OP_LITERAL:
+        for (uint16_t j = 0; j < n; j++, pos += cs) span[j] = rtzDecodeColor(packet + pos, flags);
+        pos += ((op & 0x3F) + 1 - n) * cs; // clipped at the end of the index range
+        cb(index, span, n, arg);
+        written += n;
+        break;
+    }
+    index += n;
+  }
+  return written;
+}
+
+/*
+ * Reference encoder: ops are chosen greedily, SKIP for unchanged pixels (deltas, not in keyframes),
+ * RUN for 2+ identical colors, LITERAL otherwise. Packets are split between ops; a packet starts at the
+ * first pixel it changes, so SKIPs at packet boundaries cost nothing.
+ */
+RtzEncoder::~RtzEncoder() {
+  free(_prev);
+}
+
+bool RtzEncoder::begin(uint16_t len, bool rgbw, uint8_t depth, uint8_t keyframeInterval) {
+  free(_prev);
+  _prev = (uint32_t*)malloc(((size_t)len ? len : 1) * sizeof(uint32_t));
+  _len = _prev ? len : 0;
+  _flags = (rgbw ? RTZ_FLAG_RGBW : 0) | ((depth << RTZ_DEPTH_SHIFT) & RTZ_DEPTH_MASK);
+  _interval = keyframeInterval;
+  _seq = 0;
+  _frame = 0;
+  _hasPrev = false;
+  return _prev && rtzColorSize(_flags);
+}
+
+size_t RtzEncoder::encode(const uint32_t *frame, uint8_t timeout, uint8_t *buffer, size_t maxSize, RtzPacketCallback cb, void *arg) {
+  const uint8_t cs = rtzColorSize(_flags);
+  if (!_prev || !cs || maxSize < (size_t)RTZ_HEADER_SIZE + 1 + cs) return 0;
+  const bool key = !_hasPrev || (_interval && _frame % _interval == 0);
+  const uint8_t flags = _flags | (key ? RTZ_FLAG_KEYFRAME : 0);
+
+  size_t total = 0, pos = 0; // pos == 0: no packet open
+  uint16_t i = 0;
+  while (i < _len) {
+    const uint32_t c = rtzQuantize(frame[i], flags);
+    uint16_t n = 1;
+
+    if (!key && c == _prev[i]) { // unchanged since the previous frame
+      while (i + n < _len && n < RTZ_OP_MAX_COUNT && rtzQuantize(frame[i + n], flags) == _prev[i + n]) n++;
+      if (pos && pos < maxSize) buffer[pos++] = RTZ_OP_SKIP | (n - 1);
+      else if (pos) { cb(buffer, pos, arg); total += pos; pos = 0; } // packet full, next one starts after the skip
+      i += n;
+      continue;
+    }
+
+    while (i + n < _len && n < RTZ_OP_MAX_COUNT && rtzQuantize(frame[i + n], flags) == c) n++;
+    const bool run = n > 1;
+    if (!run) { // literal up to the next run or unchanged pixels
+      uint32_t last = c;
+      while (i + n < _len && n < RTZ_OP_MAX_COUNT) {
+        uint32_t d = rtzQuantize(frame[i + n], flags);
+        if (d == last || (!key && d == _prev[i + n])) break;
+        last = d;
+        n++;
+      }
+      if (n > 1 && i + n < _len && rtzQuantize(frame[i + n], flags) == last) n--; // leave the last color to the run
+    }
+
+    const size_t need = 1 + (run ? 1 : n) * cs;
+    if (pos && pos + 1 + cs > maxSize) { cb(buffer, pos, arg); total += pos; pos = 0; }
+    if (!pos) { // new packet starting at pixel i
+      buffer[0] = RTZ_PROTOCOL;
+      buffer[1] = timeout;
+      buffer[2] = flags;
+      buffer[3] = _seq;
+      buffer[4] = i >> 8;
+      buffer[5] = i & 0xFF;
+      pos = RTZ_HEADER_SIZE;
+    }
+    if (!run && pos + need > maxSize) n = (maxSize - pos - 1) / cs; // literal truncated to fit
+
+    buffer[pos++] = (run ? RTZ_OP_RUN : RTZ_OP_LITERAL) | (n - 1);
+    for (uint16_t j = 0; j < (run ? 1 : n); j++, pos += cs) rtzEncodeColor(buffer + pos, frame[i + j], flags);
+    i += n;
+  }
+
+  if (!pos) { // frame without changes (or ending with unchanged pixels after a full packet): push only
+    buffer[0] = RTZ_PROTOCOL;
+    buffer[1] = timeout;
+    buffer[2] = flags;
+    buffer[3] = _seq;
+    buffer[4] = buffer[5] = 0;
+    pos = RTZ_HEADER_SIZE;
+  }
+  buffer[2] |= RTZ_FLAG_PUSH;
+  cb(buffer, pos, arg);
+  total += pos;
+
+  for (uint16_t j = 0; j < _len; j++) _prev[j] = rtzQuantize(frame[j], flags);
+  _hasPrev = true;
+  _seq++;
+  _frame++;
+  return total;
+}
@@ -0,0 +1,72 @@
+#ifndef WLED_REALTIME_CODEC_H
+#define WLED_REALTIME_CODEC_H
+/*
+ * Compressed realtime UDP protocol (DZ, protocol byte 6 on the WLED notifier port)
+ *
+ * Header (6 bytes):
+ *   0   6 (protocol)
+ *   1   timeout in seconds (as for WARLS/DRGB/..., 255 = no timeout)
+ *   2   flags: bit 0 keyframe, bit 1 RGBW, bit 2 push (last packet of a frame), bits 4-5 bit depth
+ *   3   frame sequence number
+ *   4-5 index of the first pixel, MSB first
+ * followed by ops, each an op byte (bits 7-6 op, bits 5-0 pixel count - 1) and its colors:
+ *   SKIP    n pixels are unchanged since the previous frame (no colors)
+ *   RUN     n pixels of the following color
+ *   LITERAL n colors follow
+ * Colors are RGB(W) with 8 bit per channel, RGB565/RGBW4444 (2 bytes, MSB first) or RGB332/RGBW2222 (1 byte).
+ * Keyframes contain no SKIP ops, receivers joining or having lost packets recover with the next keyframe.
+ *
+ * Plain C++ without Arduino dependencies so the reference encoder can be used on host for tests and benchmarks.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#define RTZ_PROTOCOL        6
+#define RTZ_HEADER_SIZE     6
+
+#define RTZ_FLAG_KEYFRAME   0x01
+#define RTZ_FLAG_RGBW       0x02
+#define RTZ_FLAG_PUSH       0x04
+#define RTZ_DEPTH_SHIFT     4
+#define RTZ_DEPTH_MASK      0x30
+
+#define RTZ_DEPTH_8         0    // 8 bit per channel
+#define RTZ_DEPTH_16        1    // RGB565 / RGBW4444
+#define RTZ_DEPTH_8BPP      2    // RGB332 / RGBW2222
+
+#define RTZ_OP_SKIP         0x00
+#define RTZ_OP_RUN          0x40
+#define RTZ_OP_LITERAL      0x80
+#define RTZ_OP_MASK         0xC0
+#define RTZ_OP_MAX_COUNT    64
+
+// receives decoded colors (0xWWRRGGBB) of consecutive pixels starting at index
+typedef void (*RtzSpanCallback)(uint16_t index, const uint32_t *colors, uint16_t count, void *arg);
+// receives one encoded packet
+typedef void (*RtzPacketCallback)(const uint8_t *packet, size_t size, void *arg);
+
+uint8_t rtzColorSize(uint8_t flags);                  // bytes per encoded color
+uint32_t rtzQuantize(uint32_t c, uint8_t flags);      // color as it will be decoded
+int rtzDecode(const uint8_t *packet, size_t size, RtzSpanCallback cb, void *arg); // returns pixels written or -1 if malformed
+
+class RtzEncoder {
+  public:
+    RtzEncoder() {}
+    ~RtzEncoder();
+
+    bool begin(uint16_t len, bool rgbw, uint8_t depth, uint8_t keyframeInterval); // keyframe every n frames (0 = first only)
+    void forceKeyframe() { _frame = 0; _hasPrev = false; }
+    // encodes a frame of len colors into packets of at most maxSize bytes, returns total bytes produced
+    size_t encode(const uint32_t *frame, uint8_t timeout, uint8_t *buffer, size_t maxSize, RtzPacketCallback cb, void *arg);
+
+  private:
+    uint32_t *_prev = nullptr;  // previous frame, quantized
+    uint16_t  _len = 0;
+    uint8_t   _flags = 0;       // RGBW and depth
+    uint8_t   _interval = 0;
+    uint8_t   _seq = 0;
+    uint32_t  _frame = 0;
+    bool      _hasPrev = false;
+};
+
+#endif
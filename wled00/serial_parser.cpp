@@ -0,0 +1,119 @@
+#include <string.h>
+#include "serial_parser.h"
+
+
+/*
+ * Adalight and TPM2 frame parser, see serial_parser.h
+ */
+
+#define TPM2_START_BYTE 0xC9
+#define TPM2_DATA_FRAME 0xDA
+#define TPM2_PING       0xAA
+#define TPM2_END_BYTE   0x36
+
+void SerialPixelParser::emit(const uint8_t *rgb, uint16_t n) {
+  _pixels(_pixel, rgb, n, _arg);
+  _pixel += n;
+  _count -= n;
+}
+
+// consumes payload bytes up to the end of the frame
+size_t SerialPixelParser::payload(const uint8_t *data, size_t len) {
+  size_t used = 0;
+  if (_partLen) { // complete the pixel started in the previous block
+    while (_partLen < 3 && used < len) _part[_partLen++] = data[used++];
+    if (_partLen < 3) return used;
+    _partLen = 0;
+    emit(_part, 1);
+  }
+  size_t n = (len - used) / 3;
+  if (n > _count) n = _count;
+  if (n) {
+    emit(data + used, n);
+    used += n * 3;
+  }
+  if (_count && used < len) { // less than a pixel left in this block
+    _partLen = len - used;
+    memcpy(_part, data + used, _partLen);
+    used = len;
+  }
+  if (!_count) {
+    if (_tpm2) _state = TPM2_Footer; // validate the end byte first
+    else {
+      _state = Header_A;
+      _frame(_arg);
+    }
+  }
+  return used;
+}
+
+size_t SerialPixelParser::feed(const uint8_t *data, size_t len) {
+  size_t i = 0;
+  while (i < len) {
+    if (_state == Data) {
+      i += payload(data + i, len - i);
+      continue;
+    }
+    const uint8_t next = data[i];
+    switch (_state) {
+      case Header_A:
+        if (next == 'A') _state = Header_d;
+        else if (next == TPM2_START_BYTE) _state = TPM2_Header_Type;
+        else return i; // command or stray byte, left to the caller
+        break;
+      case Header_d:
+        if (next == 'd') _state = Header_a;
+        else             _state = Header_A;
+        break;
+      case Header_a:
+        if (next == 'a') _state = Header_CountHi;
+        else             _state = Header_A;
+        break;
+      case Header_CountHi:
+        _pixel = 0;
+        _count = next * 0x100;
+        _check = next;
+        _state = Header_CountLo;
+        break;
+      case Header_CountLo:
+        _count += next + 1;
+        _check = _check ^ next ^ 0x55;
+        _state = Header_CountCheck;
+        break;
+      case Header_CountCheck:
+        _tpm2 = false;
+        _partLen = 0;
+        if (_check == next) _state = Data;
+        else                _state = Header_A;
+        break;
+      case TPM2_Header_Type:
+        _state = Header_A; //(unsupported) TPM2 command or invalid type
+        if (next == TPM2_DATA_FRAME) _state = TPM2_Header_CountHi;
+        else if (next == TPM2_PING) _ping(_arg);
+        break;
+      case TPM2_Header_CountHi:
+        _pixel = 0;
+        _count = next << 8; // frame size in bytes
+        _state = TPM2_Header_CountLo;
+        break;
+      case TPM2_Header_CountLo:
+        _count |= next;
+        _state = Header_A;
+        if (_count && _count % 3 == 0) { // RGB frames only
+          _count /= 3;
+          _tpm2 = true;
+          _partLen = 0;
+          _state = Data;
+        }
+        break;
+      case TPM2_Footer:
+        if (next == TPM2_END_BYTE) _frame(_arg); // otherwise drop the frame, the pixels stay unshown
+        _state = Header_A;
+        break;
+      case Data: // handled above
+        break;
+    }
+    i++;
+  }
+  return i;
+}
@@ -0,0 +1,64 @@
+#ifndef WLED_SERIAL_PARSER_H
+#define WLED_SERIAL_PARSER_H
+/*
+ * Adalight and TPM2 frame parser for serial pixel streams.
+ *
+ * feed() takes the stream in blocks of any size: frame headers are parsed byte by byte, the payload
+ * is handed on as runs of complete pixels (a pixel split between blocks is completed from the next one).
+ * A byte that does not start or continue a frame is not consumed, feed() returns there so the caller
+ * can handle it as a command (and read what follows it from the stream itself).
+ * While a payload is pending, payloadLeft() bytes can be fed without reaching such a byte.
+ *
+ * Adalight: 'A' 'd' 'a' count-1 (16 bit, MSB first) checksum (hi ^ lo ^ 0x55), then count RGB pixels.
+ * TPM2:     0xC9 0xDA size in bytes (16 bit, MSB first), RGB data, 0x36. Frames without the end byte
+ *           or with a size that is not a multiple of 3 are not shown. 0xC9 0xAA is a ping.
+ *
+ * Plain C++ without Arduino dependencies so recorded streams can be replayed on host.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+class SerialPixelParser {
+  public:
+    typedef void (*PixelsFn)(uint16_t index, const uint8_t *rgb, uint16_t count, void *arg); // consecutive pixels of the frame
+    typedef void (*EventFn)(void *arg);
+
+    SerialPixelParser(PixelsFn pixels, EventFn frame, EventFn ping, void *arg = nullptr)
+      : _pixels(pixels), _frame(frame), _ping(ping), _arg(arg) {}
+
+    size_t feed(const uint8_t *data, size_t len); // returns bytes consumed, less than len at a command byte
+    size_t payloadLeft() const { return _state == Data ? (size_t)_count * 3 - _partLen : 0; }
+    bool   isIdle() const { return _state == Header_A; }
+
+  private:
+    enum State : uint8_t {
+      Header_A,
+      Header_d,
+      Header_a,
+      Header_CountHi,
+      Header_CountLo,
+      Header_CountCheck,
+      TPM2_Header_Type,
+      TPM2_Header_CountHi,
+      TPM2_Header_CountLo,
+      Data,
+      TPM2_Footer,
+    };
+
+    size_t payload(const uint8_t *data, size_t len);
+    void   emit(const uint8_t *rgb, uint16_t n);
+
+    PixelsFn _pixels;
+    EventFn  _frame;
+    EventFn  _ping;
+    void    *_arg;
+    State    _state = Header_A;
+    uint16_t _count = 0;    // pixels of the payload left
+    uint16_t _pixel = 0;    // index of the next pixel
+    uint8_t  _check = 0;
+    bool     _tpm2 = false; // frame ends with the TPM2 end byte
+    uint8_t  _part[3];      // pixel split between blocks
+    uint8_t  _partLen = 0;
+};
+
+#endif
@@ -311,6 +311,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
 
     receiveDirect = request->hasArg(F("RD"));
     useMainSegmentOnly = request->hasArg(F("MO"));
+    t = request->arg(F("UB")).toInt();
+    if (t > 0 && t <= 255) udpRxBudget = t;
     e131SkipOutOfSequence = request->hasArg(F("ES"));
     e131Multicast = request->hasArg(F("EM"));
     t = request->arg(F("EP")).toInt();
@@ -372,7 +374,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     #endif
 
     t = request->arg(F("BD")).toInt();
-    if (t >= 96 && t <= 15000) serialBaud = t;
+    if (t >= 96 && t <= 30000) serialBaud = t;
     updateBaudRate(serialBaud *100);
   }
 
@@ -0,0 +1,99 @@
+#ifndef WLED_SPSC_RING_H
+#define WLED_SPSC_RING_H
+/*
+ * Single producer, single consumer ring of fixed size byte slots.
+ *
+ * Hands data from a network callback (producer, running in the network task or SYS context) to the
+ * main loop (consumer) without locks: the producer only advances the head, the consumer only the tail,
+ * and each index is published with release semantics after the slot it covers has been written/read.
+ * When the ring is full the producer drops the new data (acquire() returns nullptr) and counts it.
+ * The slot count is rounded down to a power of two so the free running indices map to slots across wrap.
+ *
+ * begin() and end() are not thread safe, call them only while no producer can run.
+ * Plain C++ without Arduino dependencies so it can be exercised with host threads.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <atomic>
+
+class SpscRing {
+  public:
+    SpscRing() {}
+    ~SpscRing() { end(); }
+
+    bool begin(uint16_t slots, uint16_t slotSize) {
+      end();
+      if (!slots || !slotSize) return false;
+      while (slots & (slots - 1)) slots &= slots - 1; // power of two
+      _data = (uint8_t*)malloc((size_t)slots * slotSize);
+      _len  = (uint16_t*)malloc((size_t)slots * sizeof(uint16_t));
+      if (!_data || !_len) {
+        end();
+        return false;
+      }
+      _slots = slots;
+      _slotSize = slotSize;
+      _head.store(0, std::memory_order_relaxed);
+      _tail.store(0, std::memory_order_relaxed);
+      _dropped.store(0, std::memory_order_relaxed);
+      _active.store(true, std::memory_order_release);
+      return true;
+    }
+
+    void end() {
+      _active.store(false, std::memory_order_release);
+      free(_data);
+      free(_len);
+      _data = nullptr;
+      _len = nullptr;
+      _slots = 0;
+      _slotSize = 0;
+    }
+
+    bool     isActive() const    { return _active.load(std::memory_order_acquire); }
+    uint16_t getSlots() const    { return _slots; }
+    uint16_t getSlotSize() const { return _slotSize; }
+    uint32_t getDropped() const  { return _dropped.load(std::memory_order_relaxed); }
+    uint16_t getQueued() const   { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+
+    // producer: free slot to fill (getSlotSize() bytes) or nullptr if the ring is full
+    uint8_t *acquire() {
+      uint32_t h = _head.load(std::memory_order_relaxed);
+      if (h - _tail.load(std::memory_order_acquire) >= _slots) {
+        _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      return _data + (size_t)(h & (_slots - 1)) * _slotSize;
+    }
+    // producer: slot returned by acquire() holds len bytes
+    void publish(uint16_t len) {
+      uint32_t h = _head.load(std::memory_order_relaxed);
+      _len[h & (_slots - 1)] = len;
+      _head.store(h + 1, std::memory_order_release);
+    }
+
+    // consumer: oldest queued slot or nullptr if empty
+    const uint8_t *peek(uint16_t &len) const {
+      uint32_t t = _tail.load(std::memory_order_relaxed);
+      if (t == _head.load(std::memory_order_acquire)) return nullptr;
+      len = _len[t & (_slots - 1)];
+      return _data + (size_t)(t & (_slots - 1)) * _slotSize;
+    }
+    // consumer: done with the slot returned by peek()
+    void pop() {
+      _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+  private:
+    uint8_t  *_data = nullptr;
+    uint16_t *_len  = nullptr;   // bytes used per slot
+    uint16_t  _slots = 0;
+    uint16_t  _slotSize = 0;
+    std::atomic<uint32_t> _head{0};    // next slot to write, free running
+    std::atomic<uint32_t> _tail{0};    // next slot to read, free running
+    std::atomic<uint32_t> _dropped{0}; // written by the producer only
+    std::atomic<bool>     _active{false};
+};
+
+#endif
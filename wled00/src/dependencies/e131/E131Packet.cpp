@@ -0,0 +1,39 @@
+/*
+* E131Packet.cpp
+*
+* Packet validation split from ESPAsyncE131::parsePacket(), see E131Packet.h
+*/
+
+#include "E131Packet.h"
+#include <string.h>
+
+const uint8_t E131_ACN_ID[12] = { 0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
+const uint8_t ARTNET_ID[8]    = { 0x41, 0x72, 0x74, 0x2d, 0x4e, 0x65, 0x74, 0x00 };
+
+// E1.31 fields are big endian
+static uint32_t e131Get32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+uint8_t e131PacketProtocol(const uint8_t *data, size_t len, uint16_t localPort) {
+  uint8_t protocol = P_NONE;
+
+  //E1.31 packet identifier ("ACS-E1.17")
+  if (len >= E131_ROOT_ID + sizeof(E131_ACN_ID) && !memcmp(data + E131_ROOT_ID, E131_ACN_ID, sizeof(E131_ACN_ID))) {
+    const uint32_t rootVector  = len >= E131_SYNC_PACKET_SIZE ? e131Get32(data + E131_ROOT_VECTOR) : 0;
+    const uint32_t frameVector = len >= E131_SYNC_PACKET_SIZE ? e131Get32(data + E131_FRAME_VECTOR) : 0;
+    if (rootVector == E131_VECTOR_ROOT_EXTENDED) { //E1.31 synchronization packet
+      if (frameVector == E131_VECTOR_EXTENDED_SYNC) protocol = P_E131;
+    } else if (len > E131_DMP_DATA && rootVector == E131_VECTOR_ROOT_DATA && frameVector == E131_VECTOR_DATA_PACKET
+               && data[E131_DMP_VECTOR] == E131_VECTOR_DMP_SET_PROPERTY && data[E131_DMP_DATA] == 0) { // DMX start code
+      protocol = P_E131;
+    }
+  } else if (len >= sizeof(ARTNET_ID) + 2 && !memcmp(data, ARTNET_ID, sizeof(ARTNET_ID))) {
+    const uint16_t opcode = data[8] | (data[9] << 8); // Art-Net opcodes are little endian
+    if (opcode == ARTNET_OPCODE_OPDMX || opcode == ARTNET_OPCODE_OPPOLL || opcode == ARTNET_OPCODE_OPSYNC)
+      protocol = P_ARTNET; // DMX, poll or sync packet
+  }
+
+  if (protocol == P_NONE && localPort == DDP_DEFAULT_PORT && len >= DDP_HEADER_SIZE) protocol = P_DDP;
+  return protocol;
+}
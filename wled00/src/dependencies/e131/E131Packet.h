@@ -0,0 +1,165 @@
+/*
+* E131Packet.h
+*
+* E1.31 (sACN), Art-Net and DDP packet definitions and validation, split from ESPAsyncE131.h
+* so they can be used without Arduino/network headers (packet builders, host tests).
+*
+* Project: ESPAsyncE131 - Asynchronous E.131 (sACN) library for Arduino ESP8266 and ESP32
+* Copyright (c) 2019 Shelby Merrick
+* http://www.forkineye.com
+*
+*  Project: ESPAsyncDDP - Asynchronous DDP library for Arduino ESP8266 and ESP32
+* Copyright (c) 2019 Daniel Kulp
+*
+*  This program is provided free for you to use in any way that you wish,
+*  subject to the laws and regulations where you are using it.  Due diligence
+*  is strongly suggested before using this code.  Please give credit where due.
+*
+*  The Author makes no warranty of any kind, express or implied, with regard
+*  to this program or the documentation contained in this document.  The
+*  Author shall not be liable in any event for incidental or consequential
+*  damages in connection with, or arising out of, the furnishing, performance
+*  or use of these programs.
+*/
+
+#ifndef E131PACKET_H_
+#define E131PACKET_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Defaults
+#define E131_DEFAULT_PORT   5568
+#define ARTNET_DEFAULT_PORT 6454
+#define DDP_DEFAULT_PORT    4048
+
+#define DDP_HEADER_SIZE 10
+#define DDP_PUSH_FLAG 0x01
+#define DDP_TIMECODE_FLAG 0x10
+
+#define DDP_TYPE_RGB24  0x0B // 00 001 011 (RGB , 8 bits per channel, 3 channels)
+#define DDP_TYPE_RGBW32 0x1B // 00 011 011 (RGBW, 8 bits per channel, 4 channels)
+
+#define ARTNET_OPCODE_OPDMX 0x5000
+#define ARTNET_OPCODE_OPPOLL 0x2000
+#define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
+
+#define P_E131   0
+#define P_ARTNET 1
+#define P_DDP    2
+#define P_NONE   255 // not a valid packet
+
+// E1.31 Packet Offsets
+#define E131_ROOT_PREAMBLE_SIZE 0
+#define E131_ROOT_POSTAMBLE_SIZE 2
+#define E131_ROOT_ID 4
+#define E131_ROOT_FLENGTH 16
+#define E131_ROOT_VECTOR 18
+#define E131_ROOT_CID 22
+
+#define E131_FRAME_FLENGTH 38
+#define E131_FRAME_VECTOR 40
+#define E131_FRAME_SOURCE 44
+#define E131_FRAME_PRIORITY 108
+#define E131_FRAME_RESERVED 109
+#define E131_FRAME_SEQ 111
+#define E131_FRAME_OPT 112
+#define E131_FRAME_UNIVERSE 113
+
+#define E131_DMP_FLENGTH 115
+#define E131_DMP_VECTOR 117
+#define E131_DMP_TYPE 118
+#define E131_DMP_ADDR_FIRST 119
+#define E131_DMP_ADDR_INC 121
+#define E131_DMP_COUNT 123
+#define E131_DMP_DATA 125
+
+// E1.31 Data Packet vectors
+#define E131_VECTOR_ROOT_DATA 0x00000004
+#define E131_VECTOR_DATA_PACKET 0x00000002
+#define E131_VECTOR_DMP_SET_PROPERTY 0x02
+
+// E1.31 Synchronization Packet (root vector E131_VECTOR_ROOT_EXTENDED)
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+#define E131_VECTOR_EXTENDED_SYNC 0x00000001
+#define E131_SYNC_SEQ 44
+#define E131_SYNC_ADDR 45
+#define E131_SYNC_PACKET_SIZE 49
+
+// E1.17 ACN Packet Identifier ("ASC-E1.17") and Art-Net Packet Identifier ("Art-Net")
+extern const uint8_t E131_ACN_ID[12];
+extern const uint8_t ARTNET_ID[8];
+
+// E1.31 Packet Structure
+typedef union {
+    struct { //E1.31 packet
+      // Root Layer
+      uint16_t preamble_size;
+      uint16_t postamble_size;
+      uint8_t  acn_id[12];
+      uint16_t root_flength;
+      uint32_t root_vector;
+      uint8_t  cid[16];
+
+      // Frame Layer
+      uint16_t frame_flength;
+      uint32_t frame_vector;
+      uint8_t  source_name[64];
+      uint8_t  priority;
+      uint16_t reserved;
+      uint8_t  sequence_number;
+      uint8_t  options;
+      uint16_t universe;
+
+      // DMP Layer
+      uint16_t dmp_flength;
+      uint8_t  dmp_vector;
+      uint8_t  type;
+      uint16_t first_address;
+      uint16_t address_increment;
+      uint16_t property_value_count;
+      uint8_t  property_values[513];
+    } __attribute__((packed));
+
+	struct { //Art-Net packet
+    uint8_t  art_id[8];
+    uint16_t art_opcode;
+    uint16_t art_protocol_ver;
+    uint8_t  art_sequence_number;
+    uint8_t  art_physical;
+    uint16_t art_universe;
+    uint16_t art_length;
+
+    uint8_t  art_data[512];
+  } __attribute__((packed));
+
+  struct { //DDP Header
+    uint8_t flags;
+    uint8_t sequenceNum;
+    uint8_t dataType;
+    uint8_t destination;
+    uint32_t channelOffset;
+    uint16_t dataLen;
+    uint8_t data[1];
+  } __attribute__((packed));
+
+  /*struct { //DDP Time code Header (unsupported)
+    uint8_t flags;
+    uint8_t sequenceNum;
+    uint8_t dataType;
+    uint8_t destination;
+    uint32_t channelOffset;
+    uint16_t dataLen;
+    uint32_t timeCode;
+    uint8_t data[1];
+  } __attribute__((packed));*/
+
+  uint8_t raw[1458];
+} e131_packet_t;
+
+// Validates a received packet: E1.31 data or synchronization, Art-Net DMX, poll or sync,
+// anything else on the DDP port is DDP. Returns P_E131, P_ARTNET, P_DDP or P_NONE.
+uint8_t e131PacketProtocol(const uint8_t *data, size_t len, uint16_t localPort);
+
+#endif  // E131PACKET_H_
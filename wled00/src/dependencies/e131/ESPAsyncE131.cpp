@@ -21,12 +21,6 @@
 #include "../network/Network.h"
 #include <string.h>
 
-// E1.17 ACN Packet Identifier
-const byte ESPAsyncE131::ACN_ID[12] = { 0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
-
-// Art-Net Packet Identifier
-const byte ESPAsyncE131::ART_ID[8]  = { 0x41, 0x72, 0x74, 0x2d, 0x4e, 0x65, 0x74, 0x00 };
-
 // Constructor
 ESPAsyncE131::ESPAsyncE131(e131_packet_callback_function callback) {
   _callback = callback;
@@ -98,37 +92,9 @@ bool ESPAsyncE131::initMulticast(uint16_t port, uint16_t universe, uint8_t n) {
 /////////////////////////////////////////////////////////
 
 void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
-  bool error = false;
-  uint8_t protocol = P_E131;
-
-  e131_packet_t *sbuff = reinterpret_cast<e131_packet_t *>(_packet.data());
-	
-	//E1.31 packet identifier ("ACS-E1.17")
-  if (memcmp(sbuff->acn_id, ESPAsyncE131::ACN_ID, sizeof(sbuff->acn_id)))
-    protocol = P_ARTNET;
-	
-	if (protocol == P_ARTNET) {
-		if (memcmp(sbuff->art_id, ESPAsyncE131::ART_ID, sizeof(sbuff->art_id)))
-			error = true; //not "Art-Net"
-		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL)
-			error = true; //not a DMX or poll packet
-	} else { //E1.31 error handling
-		if (htonl(sbuff->root_vector) != ESPAsyncE131::VECTOR_ROOT)
-			error = true;
-		if (htonl(sbuff->frame_vector) != ESPAsyncE131::VECTOR_FRAME)
-			error = true;
-		if (sbuff->dmp_vector != ESPAsyncE131::VECTOR_DMP)
-			error = true;
-		if (sbuff->property_values[0] != 0)
-			error = true;
-	} 
-  
-  if (error && _packet.localPort() == DDP_DEFAULT_PORT) { //DDP packet
-    error = false;
-    protocol = P_DDP;
-  }
+  uint8_t protocol = e131PacketProtocol(_packet.data(), _packet.length(), _packet.localPort());
+  if (protocol == P_NONE) return;
 
-  if (!error) {
-    _callback(sbuff, _packet.remoteIP(), protocol);
-  }
-}
\ No newline at end of file
+  if (_queue && _queue(_packet.data(), _packet.length(), _packet.remoteIP(), protocol)) return;
+  _callback(reinterpret_cast<e131_packet_t *>(_packet.data()), _packet.remoteIP(), protocol);
+}
@@ -1,4 +1,7 @@
 #include "wled.h"
+#include "realtime_codec.h"
+#include "net_out.h"
+#include "udp_drain.h"
 
 /*
  * UDP sync notifier / Realtime / Hyperion / TPM2.NET
@@ -149,8 +152,128 @@ void notify(byte callMode, bool followUp)
   notificationCount = followUp ? notificationCount + 1 : 0;
 }
 
+/*
+ * Realtime jitter buffer: while enabled, realtime pixels are collected in its write frame and each
+ * complete frame (realtimeShow()) is queued with its arrival time. handleRealtimeJitter() presents the
+ * queued frames at the smoothed arrival cadence instead of showing them as packets come in.
+ * The buffer is (re)allocated by realtimeLock() when the configuration or LED count changed, so pixel
+ * ingest only checks whether it is active. A failed allocation turns it off instead of being retried.
+ */
+static void updateRealtimeJitter() {
+  if (!realtimeJitterFrames) {
+    if (realtimeJitter.isActive()) realtimeJitter.release();
+    return;
+  }
+  if (realtimeJitter.isActive() && realtimeJitter.getFrames() == realtimeJitterFrames
+      && realtimeJitter.getLength() == strip.getLengthTotal()) return;
+  if (!realtimeJitter.allocate(realtimeJitterFrames, strip.getLengthTotal())) {
+    DEBUG_PRINTLN(F("Jitter buffer allocation failed."));
+    realtimeJitterFrames = 0;
+  }
+}
+
+static inline bool realtimeJitterReady() {
+  return realtimeJitter.isActive();
+}
+
+/*
+ * Sync latch: while frames are held for sync (realtimeHoldForSync without jitter buffer), realtime pixels
+ * are written to a back buffer instead of the busses. A frame completed while held is latched by
+ * realtimeSyncLatch() and copied to the busses by realtimeSyncShow() once the sync arrives, so packets of the
+ * next frame arriving before the sync, or a show() in between, cannot present a mix of both frames.
+ * Takes 8 bytes of heap per LED (write and latched frame), a failed allocation is not retried and data
+ * goes to the busses directly.
+ */
+static uint32_t *syncFrames = nullptr;  // write frame, followed by the latched frame
+static uint16_t  syncFramesLen = 0;
+static bool      syncLatched = false;   // latched frame not shown yet
+static bool      syncFramesFailed = false;
+
+static void updateRealtimeSyncLatch() {
+  const uint16_t len = (realtimeHoldForSync && !realtimeJitter.isActive()) ? strip.getLengthTotal() : 0;
+  if (len == syncFramesLen) return;
+  free(syncFrames);
+  syncFrames = nullptr;
+  syncFramesLen = 0;
+  syncLatched = false;
+  if (!len || syncFramesFailed) return;
+  syncFrames = (uint32_t*)calloc(2 * len, sizeof(uint32_t));
+  if (!syncFrames) {
+    DEBUG_PRINTLN(F("Sync latch allocation failed."));
+    syncFramesFailed = true;
+    return;
+  }
+  syncFramesLen = len;
+}
+
+// frame realtime pixels are collected in instead of writing them to the busses, nullptr if there is none
+static inline uint32_t *realtimeWriteFrame() {
+  if (realtimeJitter.isActive()) return realtimeJitter.getWriteFrame();
+  return syncFrames;
+}
+
+// copies a buffered frame to the busses (or the main segment)
+static void realtimePresent(const uint32_t *frame, uint16_t length) {
+  if (realtimeOverride && !useMainSegmentOnly) return;
+  if (useMainSegmentOnly) {
+    Segment &seg = strip.getMainSegment();
+    const uint16_t len = MIN(seg.length(), length);
+    for (uint16_t i = 0; i < len; i++) seg.setPixelColor(i, frame[i]);
+  } else {
+    strip.setPixelColors(0, frame, length);
+  }
+}
+
+// frame complete: queue it in the jitter buffer or show it right away
+// (data bound to segments does not enter realtime mode and is never buffered)
+void realtimeShow() {
+  if (realtimeMode && realtimeJitterReady()) {
+    realtimeJitter.commit(millis());
+    return;
+  }
+  if (realtimeMode && syncFrames) {
+    realtimePresent(syncFrames, syncFramesLen);
+    syncLatched = false; // newer than the latched frame
+  }
+  strip.show();
+}
+
+// frame complete while held for sync: keep a copy to be shown by the sync
+void realtimeSyncLatch() {
+  if (!syncFrames) return;
+  memcpy(syncFrames + syncFramesLen, syncFrames, syncFramesLen * sizeof(uint32_t));
+  syncLatched = true;
+}
+
+// sync received: show the latched frame (or the data received so far if nothing was latched)
+void realtimeSyncShow() {
+  if (!realtimeMode || !syncFrames || !syncLatched) {
+    realtimeShow();
+    return;
+  }
+  syncLatched = false;
+  realtimePresent(syncFrames + syncFramesLen, syncFramesLen);
+  strip.show();
+}
+
+static void handleRealtimeJitter() {
+  if (!realtimeMode || !realtimeJitter.isActive()) return;
+  const uint32_t *frame = realtimeJitter.present(millis(), realtimeJitterLatency, realtimeJitterInterp);
+  if (!frame || (realtimeOverride && !useMainSegmentOnly)) return;
+  realtimePresent(frame, realtimeJitter.getLength());
+  strip.show();
+}
+
+// rtzDecode() callback
+static void setRealtimeSpan(uint16_t i, const uint32_t *c, uint16_t count, void *arg)
+{
+  setRealtimeColors(i, c, count);
+}
+
 void realtimeLock(uint32_t timeoutMs, byte md)
 {
+  updateRealtimeJitter();
+  updateRealtimeSyncLatch();
   if (!realtimeMode && !realtimeOverride) {
     uint16_t stop, start;
     if (useMainSegmentOnly) {
@@ -164,6 +287,14 @@ void realtimeLock(uint32_t timeoutMs, byte md)
     }
     // clear strip/segment
     for (size_t i = start; i < stop; i++) strip.setPixelColor(i,BLACK);
+    if (realtimeJitter.isActive()) {
+      realtimeJitter.reset();
+      memset(realtimeJitter.getWriteFrame(), 0, realtimeJitter.getLength() * sizeof(uint32_t));
+    }
+    if (syncFrames) {
+      memset(syncFrames, 0, syncFramesLen * sizeof(uint32_t));
+      syncLatched = false;
+    }
     // if WLED was off and using main segment only, freeze non-main segments so they stay off
     if (useMainSegmentOnly && bri == 0) {
       for (size_t s=0; s < strip.getSegmentsNum(); s++) {
@@ -193,6 +324,7 @@ void exitRealtime() {
   realtimeTimeout = 0; // cancel realtime mode immediately
   realtimeMode = REALTIME_MODE_INACTIVE; // inform UI immediately
   realtimeIP[0] = 0;
+  realtimeJitter.reset();
   if (useMainSegmentOnly) { // unfreeze live segment again
     strip.getMainSegment().freeze = false;
   }
@@ -210,27 +342,26 @@ void sendTPM2Ack() {
 }
 
 
-void handleNotifications()
-{
-  IPAddress localIP;
-
-  //send second notification if enabled
-  if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
-    notify(notificationSentCallMode,true);
-  }
+static bool handleUdpPacket(void *);
+static void udpShow(void *) { realtimeShow(); }
+static uint32_t udpMicros() { return micros(); }
+static UdpDrain udpDrain(handleUdpPacket, udpShow, udpMicros);
 
-  if (e131NewData && millis() - strip.getLastShow() > 15)
-  {
-    e131NewData = false;
-    strip.show();
+// realtime frame from the notifier/Hyperion socket complete: shown once the receive pass is done
+// (queued right away if the jitter buffer is active, it does its own pacing)
+static void udpFrameReady()
+{
+  if (realtimeJitterReady()) {
+    realtimeShow();
+    return;
   }
+  udpDrain.frameReady();
+}
 
-  //unlock strip when realtime UDP times out
-  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
-
-  //receive UDP notifications
-  if (!udpConnected) return;
-
+// reads and handles one pending packet of the notifier, supplementary notifier or Hyperion socket
+// returns false if no packet was pending
+static bool handleUdpPacket(void *)
+{
   bool isSupp = false;
   size_t packetSize = notifierUdp.parsePacket();
   if (!packetSize && udp2Connected) {
@@ -242,32 +373,33 @@ void handleNotifications()
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
-      if (!receiveDirect) return;
-      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
+      if (!receiveDirect) return true;
+      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) {
+        udpPacketsDropped++;
+        return true;
+      }
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
-      uint16_t id = 0;
-      uint16_t totalLen = strip.getLengthTotal();
-      for (size_t i = 0; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-        id++; if (id >= totalLen) break;
-      }
-      if (!(realtimeMode && useMainSegmentOnly)) strip.show();
-      return;
+      if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return true;
+      setRealtimePixels(0, lbuf, packetSize / 3);
+      if (realtimeJitterReady() || !(realtimeMode && useMainSegmentOnly)) udpFrameReady();
+      return true;
     }
   }
 
-  if (!(receiveNotifications || receiveDirect)) return;
+  if (!packetSize) return false;
+  if (!(receiveNotifications || receiveDirect)) return true;
 
-  localIP = Network.localIP();
+  IPAddress localIP = Network.localIP();
   //notifier and UDP realtime
-  if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
-  if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
+  if (packetSize > UDP_IN_MAXSIZE) {
+    udpPacketsDropped++;
+    return true;
+  }
+  if (!isSupp && notifierUdp.remoteIP() == localIP) return true; //don't process broadcasts we send ourselves
 
   uint8_t udpIn[packetSize +1];
   uint16_t len;
@@ -276,7 +408,7 @@ void handleNotifications()
 
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
-    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
+    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return true;
 
     uint8_t unit = udpIn[39];
     NodesMap::iterator it = Nodes.find(unit);
@@ -302,15 +434,15 @@ void handleNotifications()
           build |= udpIn[40+i]<<(8*i);
       it->second.build = build;
     }
-    return;
+    return true;
   }
 
   //wled notifier, ignore if realtime packets active
   if (udpIn[0] == 0 && !realtimeMode && receiveNotifications)
   {
     //ignore notification if received within a second after sending a notification ourselves
-    if (millis() - notificationSentTime < 1000) return;
-    if (udpIn[1] > 199) return; //do not receive custom versions
+    if (millis() - notificationSentTime < 1000) return true;
+    if (udpIn[1] > 199) return true; //do not receive custom versions
 
     //compatibilityVersionByte:
     byte version = udpIn[11];
@@ -318,8 +450,8 @@ void handleNotifications()
     // if we are not part of any sync group ignore message
     if (version < 9 || version > 199) {
       // legacy senders are treated as if sending in sync group 1 only
-      if (!(receiveGroups & 0x01)) return;
-    } else if (!(receiveGroups & udpIn[36])) return;
+      if (!(receiveGroups & 0x01)) return true;
+    } else if (!(receiveGroups & udpIn[36])) return true;
 
     bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects);
 
@@ -460,10 +592,10 @@ void handleNotifications()
 
     if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
     stateUpdated(CALL_MODE_NOTIFICATION);
-    return;
+    return true;
   }
 
-  if (!receiveDirect) return;
+  if (!receiveDirect) return true;
 
   //TPM2.NET
   if (udpIn[0] == 0x9c)
@@ -472,13 +604,13 @@ void handleNotifications()
     //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
     byte tpmType = udpIn[1];
     if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
-      sendTPM2Ack(); return;
+      sendTPM2Ack(); return true;
     }
-    if (tpmType != 0xda) return; //return if notTPM2.NET data
+    if (tpmType != 0xda) return true; //return if notTPM2.NET data
 
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
-    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
+    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return true;
 
     tpmPacketCount++; //increment the packet count
     if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
@@ -486,41 +618,32 @@ void handleNotifications()
     byte numPackets = udpIn[5];
 
     uint16_t id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-    uint16_t totalLen = strip.getLengthTotal();
-    for (size_t i = 6; i < tpmPayloadFrameSize + 4U; i += 3)
-    {
-      if (id < totalLen)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-      else break;
-    }
+    uint16_t count = (packetSize > 6) ? MIN(tpmPayloadFrameSize, packetSize - 6) / 3 : 0;
+    setRealtimePixels(id, &udpIn[6], count);
     if (tpmPacketCount == numPackets) //reset packet count and show if all packets were received
     {
       tpmPacketCount = 0;
-      strip.show();
+      udpFrameReady();
     }
-    return;
+    return true;
   }
 
-  //UDP realtime: 1 warls 2 drgb 3 drgbw
-  if (udpIn[0] > 0 && udpIn[0] < 5)
+  //UDP realtime: 1 warls 2 drgb 3 drgbw 4 dnrgb 5 dnrgbw 6 dz (compressed)
+  if (udpIn[0] > 0 && udpIn[0] <= RTZ_PROTOCOL)
   {
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     DEBUG_PRINTLN(realtimeIP);
-    if (packetSize < 2) return;
+    if (packetSize < 2) return true;
 
     if (udpIn[1] == 0)
     {
       realtimeTimeout = 0;
-      return;
+      return true;
     } else {
       realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
     }
-    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
+    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return true;
 
-    uint16_t totalLen = strip.getLengthTotal();
     if (udpIn[0] == 1) //warls
     {
       for (size_t i = 2; i < packetSize -3; i += 4)
@@ -529,43 +652,28 @@ void handleNotifications()
       }
     } else if (udpIn[0] == 2) //drgb
     {
-      uint16_t id = 0;
-      for (size_t i = 2; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-
-        id++; if (id >= totalLen) break;
-      }
+      setRealtimePixels(0, &udpIn[2], (packetSize - 2) / 3);
     } else if (udpIn[0] == 3) //drgbw
     {
-      uint16_t id = 0;
-      for (size_t i = 2; i < packetSize -3; i += 4)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-
-        id++; if (id >= totalLen) break;
-      }
-    } else if (udpIn[0] == 4) //dnrgb
+      setRealtimePixels(0, &udpIn[2], (packetSize - 2) / 4, 4);
+    } else if (udpIn[0] == 4 && packetSize > 4) //dnrgb
     {
       uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2; i += 3)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-    } else if (udpIn[0] == 5) //dnrgbw
+      setRealtimePixels(id, &udpIn[4], (packetSize - 4) / 3);
+    } else if (udpIn[0] == 5 && packetSize > 4) //dnrgbw
     {
       uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2; i += 4)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        id++;
+      setRealtimePixels(id, &udpIn[4], (packetSize - 4) / 4, 4);
+    } else if (udpIn[0] == RTZ_PROTOCOL) //dz: decoded straight into the pixel buffer
+    {
+      if (rtzDecode(udpIn, packetSize, setRealtimeSpan, nullptr) < 0) { // malformed
+        udpPacketsDropped++;
+        return true;
       }
+      if (!(udpIn[2] & RTZ_FLAG_PUSH)) return true; // more packets of this frame to come
     }
-    strip.show();
-    return;
+    udpFrameReady();
+    return true;
   }
 
   // API over UDP
@@ -583,8 +691,42 @@ void handleNotifications()
     }
     releaseJSONBufferLock();
   }
+  return true;
 }
 
+void handleNotifications()
+{
+  //send second notification if enabled
+  if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
+    notify(notificationSentCallMode,true);
+  }
+
+  handleRealtimeRx();
+  bool syncNow = handleRealtimeSync();
+  if (e131NewData && (syncNow || realtimeJitter.isActive() || millis() - strip.getLastShow() > 15))
+  {
+    e131NewData = false;
+    if (syncNow) realtimeSyncShow();
+    else         realtimeShow();
+  }
+  handleRealtimeJitter();
+
+  //unlock strip when realtime UDP times out
+  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
+
+  //receive UDP notifications
+  if (!udpConnected) return;
+
+  // drain all pending packets within the time budget, realtime frames completed in the same pass are
+  // coalesced so only the newest one is shown
+  udpDrain.drain(udpRxBudget * 1000UL);
+  const UdpDrain::Stats &s = udpDrain.getStats();
+  udpPacketsReceived  = s.handled;
+  udpFramesSuperseded = s.superseded;
+  udpRxBudgetExceeded = s.exceeded;
+}
+
+
 
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
 {
@@ -596,7 +738,10 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
       b = gamma8(b);
       w = gamma8(w);
     }
-    if (useMainSegmentOnly) {
+    uint32_t *frame = realtimeWriteFrame();
+    if (frame) {
+      frame[pix] = RGBW32(r, g, b, w);
+    } else if (useMainSegmentOnly) {
       Segment &seg = strip.getMainSegment();
       if (pix<seg.length()) seg.setPixelColor(pix, r, g, b, w);
     } else {
@@ -605,6 +750,103 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   }
 }
 
+// bulk version of setRealtimePixel(): count pixels of bpp bytes (3 = RGB, 4 = RGBW) starting at pixel i
+// gamma and offset are resolved once per call and consecutive pixels are handed to the busses as spans
+#define REALTIME_SPAN 32
+void setRealtimePixels(uint16_t i, const byte *data, uint16_t count, uint8_t bpp)
+{
+  int32_t pix = i + arlsOffset;
+  const int32_t totalLen = strip.getLengthTotal();
+  if (pix < 0) { // negative offset cuts off the start of the payload
+    if (count <= -pix) return;
+    data  += -pix * bpp;
+    count -= -pix;
+    pix = 0;
+  }
+  if (pix >= totalLen) return;
+  if (count > totalLen - pix) count = totalLen - pix;
+  const bool applyGamma = !arlsDisableGammaCorrection && gammaCorrectCol;
+
+  uint32_t *frame = realtimeWriteFrame();
+  if (frame) {
+    frame += pix;
+    for (uint16_t j = 0; j < count; j++, data += bpp) {
+      byte w = bpp > 3 ? data[3] : 0;
+      if (applyGamma) frame[j] = RGBW32(gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), gamma8(w));
+      else            frame[j] = RGBW32(data[0], data[1], data[2], w);
+    }
+    return;
+  }
+
+  if (useMainSegmentOnly) {
+    Segment &seg = strip.getMainSegment();
+    const int32_t segLen = seg.length();
+    for (uint16_t j = 0; j < count && pix < segLen; j++, pix++, data += bpp) {
+      byte w = bpp > 3 ? data[3] : 0;
+      if (applyGamma) seg.setPixelColor(pix, gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), gamma8(w));
+      else            seg.setPixelColor(pix, data[0], data[1], data[2], w);
+    }
+    return;
+  }
+
+  uint32_t span[REALTIME_SPAN];
+  while (count) {
+    uint16_t n = count < REALTIME_SPAN ? count : REALTIME_SPAN;
+    if (applyGamma) {
+      for (uint16_t j = 0; j < n; j++, data += bpp) span[j] = RGBW32(gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), bpp > 3 ? gamma8(data[3]) : 0);
+    } else {
+      for (uint16_t j = 0; j < n; j++, data += bpp) span[j] = RGBW32(data[0], data[1], data[2], bpp > 3 ? data[3] : 0);
+    }
+    strip.setPixelColors(pix, span, n);
+    pix   += n;
+    count -= n;
+  }
+}
+
+// colors (0xWWRRGGBB) version of setRealtimePixels()
+void setRealtimeColors(uint16_t i, const uint32_t *c, uint16_t count)
+{
+  int32_t pix = i + arlsOffset;
+  const int32_t totalLen = strip.getLengthTotal();
+  if (pix < 0) {
+    if (count <= -pix) return;
+    c     += -pix;
+    count -= -pix;
+    pix = 0;
+  }
+  if (pix >= totalLen) return;
+  if (count > totalLen - pix) count = totalLen - pix;
+  const bool applyGamma = !arlsDisableGammaCorrection && gammaCorrectCol;
+
+  uint32_t *frame = realtimeWriteFrame();
+  if (frame) {
+    frame += pix;
+    for (uint16_t j = 0; j < count; j++) frame[j] = applyGamma ? gamma32(c[j]) : c[j];
+    return;
+  }
+
+  if (useMainSegmentOnly) {
+    Segment &seg = strip.getMainSegment();
+    const int32_t segLen = seg.length();
+    for (uint16_t j = 0; j < count && pix < segLen; j++, pix++) seg.setPixelColor(pix, applyGamma ? gamma32(c[j]) : c[j]);
+    return;
+  }
+
+  if (!applyGamma) {
+    strip.setPixelColors(pix, c, count);
+    return;
+  }
+  uint32_t span[REALTIME_SPAN];
+  while (count) {
+    uint16_t n = count < REALTIME_SPAN ? count : REALTIME_SPAN;
+    for (uint16_t j = 0; j < n; j++) span[j] = gamma32(c[j]);
+    strip.setPixelColors(pix, span, n);
+    c     += n;
+    pix   += n;
+    count -= n;
+  }
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -686,23 +928,38 @@ void sendSysInfoUDP()
  * Art-Net, DDP, E131 output - work in progress
 \*********************************************************************************************/
 
-#define DDP_HEADER_LEN 10
-#define DDP_SYNCPACKET_LEN 10
+// packets are assembled by net_out.cpp, sent here
+static NetOut netOut;
 
-#define DDP_FLAGS1_VER 0xc0  // version mask
-#define DDP_FLAGS1_VER1 0x40 // version=1
-#define DDP_FLAGS1_PUSH 0x01
-#define DDP_FLAGS1_QUERY 0x02
-#define DDP_FLAGS1_REPLY 0x04
-#define DDP_FLAGS1_STORAGE 0x08
-#define DDP_FLAGS1_TIME 0x10
+struct NetOutTarget {
+  WiFiUDP   udp;
+  IPAddress client;
+};
 
-#define DDP_ID_DISPLAY 1
-#define DDP_ID_CONFIG 250
-#define DDP_ID_STATUS 251
+static bool netOutSend(uint16_t port, const uint8_t *packet, size_t size, void *arg) {
+  NetOutTarget *t = (NetOutTarget*)arg;
+  if (!t->udp.beginPacket(t->client, port)) {
+    DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
+    return false;
+  }
+  t->udp.write(packet, size);
+  if (!t->udp.endPacket()) {
+    DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
+    return false;
+  }
+  return true;
+}
 
-// 1440 channels per packet
-#define DDP_CHANNELS_PER_PACKET 1440 // 480 leds
+static void netOutParams(NetOutParams &p, uint8_t type, uint8_t *mac) {
+  WiFi.macAddress(mac);
+  p.type     = type;
+  p.rgbw     = false;
+  p.syncOut  = realtimeSyncOut;
+  p.priority = e131Priority;
+  p.source   = serverDescription;
+  p.mac      = mac;
+  p.lut      = nullptr;
+}
 
 //
 // Send real time UDP updates to the specified client
@@ -712,139 +969,40 @@ void sendSysInfoUDP()
 // length - the number of pixels
 // buffer - a buffer of at least length*4 bytes long
 // isRGBW - true if the buffer contains 4 components per pixel
-
-static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
-static const size_t ART_NET_HEADER_SIZE = 12;
-static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
-
+//
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW)  {
   if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
+  if (type > 2) return 1;
+
+  uint8_t mac[6];
+  NetOutParams p;
+  netOutParams(p, type, mac);
+  p.rgbw = isRGBW;
+
+  // brightness LUT, built once per frame instead of scaling every channel
+  byte briLUT[256];
+  if (bri < 255) {
+    for (int v = 0; v < 256; v++) briLUT[v] = scale8(v, bri);
+    p.lut = briLUT;
+  }
 
-  WiFiUDP ddpUdp;
-
-  switch (type) {
-    case 0: // DDP
-    {
-      // calculate the number of UDP packets we need to send
-      size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B value
-      size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
-
-      // there are 3 channels per RGB pixel
-      uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-        if (sequenceNumber > 15) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
-        // the amount of data is AFTER the header in the current packet
-        size_t packetSize = DDP_CHANNELS_PER_PACKET;
-
-        uint8_t flags = DDP_FLAGS1_VER1;
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet, set the push flag
-          // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-          flags = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
-          if (channelCount % DDP_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
-          }
-        }
-
-        // write the header
-        /*0*/ddpUdp.write(flags);
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
-        // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
-        // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
-          return 1; // problem
-        }
-
-        channel += packetSize;
-      }
-    } break;
-
-    case 1: //E1.31
-    {
-    } break;
-
-    case 2: //ArtNet
-    {
-      // calculate the number of UDP packets we need to send
-      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
-      const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
-      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
-
-      uint32_t channel = 0; 
-      size_t bufferOffset = 0;
-
-      sequenceNumber++;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
-        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
-
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet
-          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
-          }
-        }
-
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+  NetOutTarget target;
+  target.client = client;
+  return netOut.frame(p, buffer, length, netOutSend, &target) ? 0 : 1;
+}
 
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
-          return 1; // borked
-        }
-        channel += packetSize;
-      }
-    } break;
-  }
-  return 0;
+//
+// Send a frame sync to the specified client after data has been sent to all outputs
+// (DDP push, E1.31 synchronization packet or ArtSync), so all receivers show the frame at once
+//
+uint8_t realtimeBroadcastSync(uint8_t type, IPAddress client) {
+  if (!(apActive || interfacesInited) || !client[0]) return 1;
+  if (!realtimeSyncOut || type > 2) return 1;
+
+  uint8_t mac[6];
+  NetOutParams p;
+  netOutParams(p, type, mac);
+  NetOutTarget target;
+  target.client = client;
+  return netOut.sync(p, netOutSend, &target) ? 0 : 1;
 }
@@ -0,0 +1,28 @@
+#include "udp_drain.h"
+
+/*
+ * UDP receive pass, see udp_drain.h
+ */
+
+void UdpDrain::frameReady() {
+  if (_pending) _stats.superseded++;
+  _pending = true;
+}
+
+uint16_t UdpDrain::drain(uint32_t budgetUs) {
+  uint16_t handled = 0;
+  const uint32_t start = _clock();
+  while (_handle(_arg)) {
+    handled++;
+    _stats.handled++;
+    if (_clock() - start >= budgetUs) {
+      _stats.exceeded++;
+      break;
+    }
+  }
+  if (_pending) {
+    _pending = false;
+    _show(_arg);
+  }
+  return handled;
+}
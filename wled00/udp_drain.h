@@ -0,0 +1,42 @@
+#ifndef WLED_UDP_DRAIN_H
+#define WLED_UDP_DRAIN_H
+/*
+ * Receive pass over the notifier/Hyperion UDP sockets: pending packets are handled until none is
+ * left or the time budget is used up, realtime frames completed during the pass are coalesced so
+ * only the newest one is shown (once, at the end of the pass).
+ *
+ * Plain C++ without Arduino dependencies: sockets, show and clock are reached through callbacks,
+ * so the pass can be run on host against a stand-in socket queue and a fake clock.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+class UdpDrain {
+  public:
+    typedef bool     (*HandleFn)(void *arg); // reads and handles one pending packet, false if none was pending
+    typedef void     (*ShowFn)(void *arg);   // shows the pixel buffer
+    typedef uint32_t (*ClockFn)();           // microseconds, wrapping
+
+    struct Stats {
+      uint32_t handled;    // packets handled
+      uint32_t superseded; // realtime frames overwritten by a newer one before being shown
+      uint32_t exceeded;   // passes cut short by the budget
+    };
+
+    UdpDrain(HandleFn handle, ShowFn show, ClockFn clock, void *arg = nullptr)
+      : _handle(handle), _show(show), _clock(clock), _arg(arg) {}
+
+    void     frameReady();                  // called by the handler: a realtime frame is complete in the pixel buffer
+    uint16_t drain(uint32_t budgetUs);      // one receive pass, returns packets handled
+    const Stats &getStats() const { return _stats; }
+
+  private:
+    HandleFn _handle;
+    ShowFn   _show;
+    ClockFn  _clock;
+    void    *_arg;
+    bool     _pending = false; // frame completed during this pass, not shown yet
+    Stats    _stats = {};
+};
+
+#endif
@@ -164,6 +164,7 @@ void WLED::loop()
     else strip.fixInvalidSegments();
     doSerializeConfig = true;
   }
+  if (doAllocCrossfade) doAllocCrossfade = !strip.allocateCrossfadePool(); // retried until running crossfades finished
   if (loadLedmap >= 0) {
     if (!strip.deserializeMap(loadLedmap) && strip.isMatrix && loadLedmap == 0) strip.setUpMatrix();
     loadLedmap = -1;
@@ -266,6 +267,12 @@ void WLED::setup()
   #ifdef ARDUINO_ARCH_ESP32
   pinMode(hardwareRX, INPUT_PULLDOWN); delay(1);        // suppress noise in case RX pin is floating (at low noise energy) - see issue #3128
   #endif
+  #if defined(WLED_ENABLE_ADALIGHT) && !ARDUINO_USB_CDC_ON_BOOT
+  Serial.setRxBufferSize(WLED_SERIAL_RX_BUFFER); // must precede begin() on ESP32
+    #if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 2
+  Serial.setTxBufferSize(WLED_SERIAL_TX_BUFFER);
+    #endif
+  #endif
   Serial.begin(115200);
   #if !ARDUINO_USB_CDC_ON_BOOT
   Serial.setTimeout(50);  // this causes troubles on new MCUs that have a "virtual" USB Serial (HWCDC)
@@ -169,6 +169,8 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "NodeStruct.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
+#include "jitter_buffer.h"
+#include "spsc_ring.h"
 #include "FX.h"
 
 #ifndef CLIENT_SSID
@@ -410,6 +412,16 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL uint8_t e131FrameDeadline _INIT(20);                  // ms to wait for all universes of a multi universe frame
+WLED_GLOBAL uint32_t e131FramesComplete _INIT(0);                 // multi universe frames shown with all universes
+WLED_GLOBAL uint32_t e131FramesPartial _INIT(0);                  // multi universe frames shown with universes missing
+WLED_GLOBAL uint32_t e131LateUniverses _INIT(0);                  // universes received after their frame was shown
+WLED_GLOBAL byte realtimeJitterFrames _INIT(0);                   // realtime frames to buffer for smoothed presentation (0 = off)
+WLED_GLOBAL uint16_t realtimeJitterLatency _INIT(50);             // target delay (ms) between arrival and presentation of buffered frames
+WLED_GLOBAL bool realtimeJitterInterp _INIT(true);                // blend into a late frame instead of stepping
+WLED_GLOBAL bool realtimeHoldForSync _INIT(false);                // hold received realtime frames until ArtSync / E1.31 sync / DDP push (8 bytes of heap per LED without jitter buffer)
+WLED_GLOBAL uint16_t realtimeSyncTimeout _INIT(250);              // ms without sync after which held frames are shown free running
+WLED_GLOBAL bool realtimeSyncOut _INIT(false);                    // network busses send a sync after each frame instead of per packet push
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
@@ -443,6 +455,7 @@ WLED_GLOBAL bool hueApplyColor _INIT(true);
 #endif
 
 WLED_GLOBAL uint16_t serialBaud _INIT(1152); // serial baud rate, multiply by 100
+WLED_GLOBAL uint32_t serialFramesSkipped _INIT(0); // TPM2 output frames skipped while the previous one was being sent
 
 // Time CONFIG
 WLED_GLOBAL bool ntpEnabled _INIT(false);    // get internet time. Only required if you use clock overlays or time-activated macros
@@ -652,6 +665,7 @@ WLED_GLOBAL byte optionType;
 WLED_GLOBAL bool doSerializeConfig _INIT(false);        // flag to initiate saving of config
 WLED_GLOBAL bool doReboot          _INIT(false);        // flag to initiate reboot from async handlers
 WLED_GLOBAL bool doPublishMqtt     _INIT(false);
+WLED_GLOBAL bool doAllocCrossfade  _INIT(false);        // flag to (re)allocate crossfade buffer pool after light.tr.fx changed
 
 // status led
 #if defined(STATUSLED)
@@ -674,9 +688,18 @@ WLED_GLOBAL WiFiUDP ntpUdp;
 WLED_GLOBAL ESPAsyncE131 e131 _INIT_N(((handleE131Packet)));
 WLED_GLOBAL ESPAsyncE131 ddp  _INIT_N(((handleE131Packet)));
 WLED_GLOBAL bool e131NewData _INIT(false);
+WLED_GLOBAL byte udpRxBudget _INIT(5);                     // ms per loop to drain pending UDP packets
+WLED_GLOBAL uint32_t udpPacketsReceived _INIT(0);          // notifier/Hyperion packets handled
+WLED_GLOBAL uint32_t udpPacketsDropped _INIT(0);           // packets discarded (oversized, too short, malformed)
+WLED_GLOBAL uint32_t udpFramesSuperseded _INIT(0);         // realtime frames overwritten by a newer one before being shown
+WLED_GLOBAL uint32_t udpRxBudgetExceeded _INIT(0);         // receive passes cut short by udpRxBudget
+WLED_GLOBAL byte realtimeRxQueue _INIT(0);                 // E1.31/Art-Net/DDP packets queued from the network context (0 = handled there unless a segment is bound to live data), 1466 bytes of heap each
+WLED_GLOBAL uint16_t realtimeRxQueuePeak _INIT(0);         // most packets found queued at once
+WLED_GLOBAL uint32_t realtimeRxQueueDropped _INIT(0);      // packets dropped because the queue was full
 
 // led fx library object
 WLED_GLOBAL BusManager busses _INIT(BusManager());
+WLED_GLOBAL JitterBuffer realtimeJitter;
 WLED_GLOBAL WS2812FX strip _INIT(WS2812FX());
 WLED_GLOBAL BusConfig* busConfigs[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES] _INIT({nullptr}); //temporary, to remember values from network callback until after
 WLED_GLOBAL bool doInitBusses _INIT(false);
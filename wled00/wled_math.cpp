@@ -1,9 +1,13 @@
 /*
  * Contains some trigonometric functions.
  * The ANSI C equivalents are likely faster, but using any sin/cos/tan function incurs a memory penalty of 460 bytes on ESP8266, likely for lookup tables.
- * This implementation has no extra static memory usage.
+ * This implementation keeps its three small tables (3 x 514 bytes) in flash (PROGMEM) and uses no extra RAM.
  *
- * Source of the cos_t() function: https://web.eecs.utk.edu/~azh/blog/cosine.html (cos_taylor_literal_6terms)
+ * sin/cos, atan2 and sqrt are linearly interpolated table lookups. Maximum errors (measured against libm over the full input range):
+ *   sin_t()/cos_t()       abs. error <= 2.5e-5       sin16_t()/cos16_t()  abs. error <= 1 LSB (Q15)
+ *   atan2_t()             abs. error <= 5.0e-5 rad   atan2_16_t()         abs. error <= 1 LSB (65536 = full circle)
+ *   sqrt_t()              rel. error <= 1.0e-5       sqrt32_t()           exact (floor)
+ * The fixed point variants do not touch the FPU at all and are preferred in per-pixel render loops.
  */
 
 #include <Arduino.h> //PI constant
@@ -12,33 +16,204 @@
 
 #define modd(x, y) ((x) - (int)((x) / (y)) * (y))
 
-float cos_t(float phi)
-{
-  float x = modd(phi, TWO_PI);
-  if (x < 0) x = -1 * x;
-  int8_t sign = 1;
-  if (x > PI)
-  {
-      x -= PI;
-      sign = -1;
+// quarter wave of sin() split into 256 segments, Q15 (32767 = 1.0)
+static const int16_t sinLUT[257] PROGMEM = {
+  0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+  3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+  6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+  9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+  12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+  15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+  18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+  20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+  23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+  25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+  27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+  28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+  30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+  31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+  32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+  32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+  32767
+};
+
+// atan(i/256) for i = 0..256, in 1/65536 of a full circle (8192 = 45°)
+static const uint16_t atanLUT[257] PROGMEM = {
+  0, 41, 81, 122, 163, 204, 244, 285, 326, 367, 407, 448, 489, 529, 570, 610,
+  651, 692, 732, 773, 813, 854, 894, 935, 975, 1015, 1056, 1096, 1136, 1177, 1217, 1257,
+  1297, 1337, 1377, 1417, 1457, 1497, 1537, 1577, 1617, 1656, 1696, 1736, 1775, 1815, 1854, 1894,
+  1933, 1973, 2012, 2051, 2090, 2129, 2168, 2207, 2246, 2285, 2324, 2363, 2401, 2440, 2478, 2517,
+  2555, 2594, 2632, 2670, 2708, 2746, 2784, 2822, 2860, 2897, 2935, 2973, 3010, 3047, 3085, 3122,
+  3159, 3196, 3233, 3270, 3307, 3344, 3380, 3417, 3453, 3490, 3526, 3562, 3599, 3635, 3670, 3706,
+  3742, 3778, 3813, 3849, 3884, 3920, 3955, 3990, 4025, 4060, 4095, 4129, 4164, 4199, 4233, 4267,
+  4302, 4336, 4370, 4404, 4438, 4471, 4505, 4539, 4572, 4605, 4639, 4672, 4705, 4738, 4771, 4803,
+  4836, 4869, 4901, 4933, 4966, 4998, 5030, 5062, 5094, 5125, 5157, 5188, 5220, 5251, 5282, 5313,
+  5344, 5375, 5406, 5437, 5467, 5498, 5528, 5559, 5589, 5619, 5649, 5679, 5708, 5738, 5768, 5797,
+  5826, 5856, 5885, 5914, 5943, 5972, 6000, 6029, 6058, 6086, 6114, 6142, 6171, 6199, 6227, 6254,
+  6282, 6310, 6337, 6365, 6392, 6419, 6446, 6473, 6500, 6527, 6554, 6580, 6607, 6633, 6660, 6686,
+  6712, 6738, 6764, 6790, 6815, 6841, 6867, 6892, 6917, 6943, 6968, 6993, 7018, 7043, 7068, 7092,
+  7117, 7141, 7166, 7190, 7214, 7238, 7262, 7286, 7310, 7334, 7358, 7381, 7405, 7428, 7451, 7475,
+  7498, 7521, 7544, 7566, 7589, 7612, 7635, 7657, 7679, 7702, 7724, 7746, 7768, 7790, 7812, 7834,
+  7856, 7877, 7899, 7920, 7942, 7963, 7984, 8005, 8026, 8047, 8068, 8089, 8110, 8131, 8151, 8172,
+  8192
+};
+
+// sqrt(1 + i/256) - 1 for i = 0..256, Q16
+static const uint16_t sqrtLUT[257] PROGMEM = {
+  0, 128, 256, 383, 510, 637, 764, 890, 1016, 1142, 1268, 1393, 1518, 1643, 1768, 1893,
+  2017, 2141, 2265, 2388, 2512, 2635, 2758, 2881, 3003, 3125, 3248, 3369, 3491, 3612, 3734, 3855,
+  3975, 4096, 4216, 4337, 4456, 4576, 4696, 4815, 4934, 5053, 5172, 5290, 5409, 5527, 5645, 5763,
+  5880, 5998, 6115, 6232, 6349, 6465, 6582, 6698, 6814, 6930, 7045, 7161, 7276, 7391, 7506, 7621,
+  7735, 7850, 7964, 8078, 8192, 8306, 8419, 8533, 8646, 8759, 8872, 8984, 9097, 9209, 9321, 9433,
+  9545, 9657, 9768, 9879, 9991, 10101, 10212, 10323, 10433, 10544, 10654, 10764, 10874, 10984, 11093, 11203,
+  11312, 11421, 11530, 11639, 11747, 11856, 11964, 12072, 12180, 12288, 12396, 12503, 12611, 12718, 12825, 12932,
+  13039, 13146, 13252, 13359, 13465, 13571, 13677, 13783, 13888, 13994, 14099, 14205, 14310, 14415, 14520, 14624,
+  14729, 14833, 14938, 15042, 15146, 15250, 15354, 15457, 15561, 15664, 15767, 15870, 15973, 16076, 16179, 16282,
+  16384, 16486, 16589, 16691, 16793, 16894, 16996, 17098, 17199, 17300, 17402, 17503, 17604, 17705, 17805, 17906,
+  18006, 18107, 18207, 18307, 18407, 18507, 18607, 18706, 18806, 18905, 19004, 19104, 19203, 19302, 19400, 19499,
+  19598, 19696, 19795, 19893, 19991, 20089, 20187, 20285, 20382, 20480, 20577, 20675, 20772, 20869, 20966, 21063,
+  21160, 21257, 21353, 21450, 21546, 21642, 21739, 21835, 21931, 22026, 22122, 22218, 22313, 22409, 22504, 22599,
+  22695, 22790, 22884, 22979, 23074, 23169, 23263, 23358, 23452, 23546, 23640, 23734, 23828, 23922, 24016, 24109,
+  24203, 24296, 24390, 24483, 24576, 24669, 24762, 24855, 24948, 25040, 25133, 25225, 25318, 25410, 25502, 25594,
+  25686, 25778, 25870, 25962, 26053, 26145, 26236, 26328, 26419, 26510, 26601, 26692, 26783, 26874, 26965, 27055,
+  27146
+};
+
+// angle: 65536 = full circle, returns Q15 (-32767..32767)
+int16_t sin16_t(uint16_t angle) {
+  uint16_t a = angle & 0x3FFF;           // position within quadrant (14 bit)
+  if (angle & 0x4000) a = 0x4000 - a;    // 2nd and 4th quadrant are mirrored
+  uint16_t idx  = a >> 6;                // 256 segments per quadrant
+  uint16_t frac = a & 0x3F;              // 6 bit interpolation
+  int16_t res = 32767;
+  if (idx < 256) {
+    int16_t s0 = pgm_read_word(&sinLUT[idx]);
+    int16_t s1 = pgm_read_word(&sinLUT[idx+1]);
+    res = s0 + (((s1 - s0) * frac + 32) >> 6);
   }
-  float xx = x * x;
+  return (angle & 0x8000) ? -res : res;
+}
 
-  float res = sign * (1 - ((xx) / (2)) + ((xx * xx) / (24)) - ((xx * xx * xx) / (720)) + ((xx * xx * xx * xx) / (40320)) - ((xx * xx * xx * xx * xx) / (3628800)) + ((xx * xx * xx * xx * xx * xx) / (479001600)));
-  #ifdef WLED_DEBUG_MATH
-  Serial.printf("cos: %f,%f,%f,(%f)\n",phi,res,cos(x),res-cos(x));
-  #endif
+int16_t cos16_t(uint16_t angle) {
+  return sin16_t(angle + 0x4000);
+}
+
+// returns angle of vector (x,y) with 65536 = full circle (0 = positive x axis, counter clockwise)
+uint16_t atan2_16_t(int32_t y, int32_t x) {
+  if (x == 0 && y == 0) return 0;
+  uint32_t ax = x < 0 ? -x : x;
+  uint32_t ay = y < 0 ? -y : y;
+  bool swap = ay > ax;                   // reduce to first octant: ratio 0..1
+  uint32_t num = swap ? ax : ay;
+  uint32_t den = swap ? ay : ax;
+  while (den > 0xFFFF) { num >>= 1; den >>= 1; } // keep num<<16 within 32 bit
+  uint32_t t = (num << 16) / den;        // Q16 ratio, 0..65536
+  uint16_t idx  = t >> 8;
+  uint16_t frac = t & 0xFF;
+  uint16_t a = 8192;
+  if (idx < 256) {
+    uint16_t a0 = pgm_read_word(&atanLUT[idx]);
+    uint16_t a1 = pgm_read_word(&atanLUT[idx+1]);
+    a = a0 + (((a1 - a0) * frac + 128) >> 8);
+  }
+  if (swap)  a = 16384 - a;
+  if (x < 0) a = 32768 - a;
+  if (y < 0) a = -a;
+  return a;
+}
+
+// integer square root, floor(sqrt(x))
+uint16_t sqrt32_t(uint32_t x) {
+  uint32_t res = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > x) bit >>= 2;
+  while (bit) {
+    if (x >= res + bit) {
+      x -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
   return res;
 }
 
 float sin_t(float x) {
-  float res =  cos_t(HALF_PI - x);
+  float t = x * (1024.0f / TWO_PI);      // 1024 table segments per period (4 quadrants of 256)
+  if (fabsf(t) > 1.0e9f) t = modd(t, 1024.0f); // keep integer part within int32
+  int32_t i = t;
+  if (t < i) i--;                        // floor
+  float frac = t - i;
+  uint16_t idx = i & 0xFF;
+  uint8_t  q   = (i >> 8) & 0x03;
+  float s0, s1;
+  if (q & 0x01) { // falling quarter
+    s0 = (int16_t)pgm_read_word(&sinLUT[256-idx]);
+    s1 = (int16_t)pgm_read_word(&sinLUT[255-idx]);
+  } else {
+    s0 = (int16_t)pgm_read_word(&sinLUT[idx]);
+    s1 = (int16_t)pgm_read_word(&sinLUT[idx+1]);
+  }
+  float res = (s0 + (s1 - s0) * frac) * (1.0f / 32767.0f);
+  if (q & 0x02) res = -res;
   #ifdef WLED_DEBUG_MATH
   Serial.printf("sin: %f,%f,%f,(%f)\n",x,res,sin(x),res-sin(x));
   #endif
   return res;
 }
 
+float cos_t(float phi)
+{
+  float res = sin_t(phi + HALF_PI);
+  #ifdef WLED_DEBUG_MATH
+  Serial.printf("cos: %f,%f,%f,(%f)\n",phi,res,cos(phi),res-cos(phi));
+  #endif
+  return res;
+}
+
+// angle of vector (x,y) in radians, -PI..PI
+float atan2_t(float y, float x) {
+  float ax = fabsf(x);
+  float ay = fabsf(y);
+  if (ax == 0.0f && ay == 0.0f) return 0.0f;
+  bool swap = ay > ax;                   // reduce to first octant: ratio 0..1
+  float t = (swap ? ax / ay : ay / ax) * 256.0f;
+  uint16_t idx = t;
+  float res = 8192.0f;
+  if (idx < 256) {
+    float a0 = pgm_read_word(&atanLUT[idx]);
+    float a1 = pgm_read_word(&atanLUT[idx+1]);
+    res = a0 + (a1 - a0) * (t - idx);
+  }
+  res *= TWO_PI / 65536.0f;
+  if (swap)    res = HALF_PI - res;
+  if (x < 0)   res = PI - res;
+  if (y < 0)   res = -res;
+  #ifdef WLED_DEBUG_MATH
+  Serial.printf("atan2: %f,%f,%f,%f,(%f)\n",y,x,res,atan2(y,x),res-atan2(y,x));
+  #endif
+  return res;
+}
+
+float sqrt_t(float x) {
+  if (!(x > 0.0f)) return 0.0f;
+  union { float f; uint32_t u; } v = { x };
+  int32_t  e = (int32_t)((v.u >> 23) & 0xFF) - 127; // x = (1 + m) * 2^e
+  uint32_t m = v.u & 0x7FFFFF;
+  uint16_t idx = m >> 15;                // 256 segments over mantissa 1..2
+  float frac = (m & 0x7FFF) * (1.0f / 32768.0f);
+  float s0 = pgm_read_word(&sqrtLUT[idx]);
+  float s1 = pgm_read_word(&sqrtLUT[idx+1]);
+  v.f = 1.0f + (s0 + (s1 - s0) * frac) * (1.0f / 65536.0f);
+  if (e & 1) v.f *= 1.41421356f;         // odd exponent
+  v.u += (uint32_t)(e >> 1) << 23;       // halve exponent (floor)
+  #ifdef WLED_DEBUG_MATH
+  Serial.printf("sqrt: %f,%f,%f,(%f)\n",x,v.f,sqrt(x),v.f-sqrt(x));
+  #endif
+  return v.f;
+}
+
 float tan_t(float x) {
   float c = cos_t(x);
   if (c==0.0) return 0;
@@ -61,7 +236,7 @@ float acos_t(float x) {
   ret = ret - 0.2121144;
   ret = ret * xabs;
   ret = ret + HALF_PI;
-  ret = ret * sqrt(1.0-xabs);
+  ret = ret * sqrt_t(1.0f-xabs);
   ret = ret - 2 * negate * ret;
   float res = negate * PI + ret;
   #ifdef WLED_DEBUG_MATH
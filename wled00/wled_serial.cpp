@@ -1,32 +1,44 @@
 #include "wled.h"
+#include "serial_parser.h"
 
 /*
  * Adalight and TPM2 handler
  */
 
-enum class AdaState {
-  Header_A,
-  Header_d,
-  Header_a,
-  Header_CountHi,
-  Header_CountLo,
-  Header_CountCheck,
-  Data_Red,
-  Data_Green,
-  Data_Blue,
-  TPM2_Header_Type,
-  TPM2_Header_CountHi,
-  TPM2_Header_CountLo,
-};
+#define ADA_CHUNK_PIXELS 64   // pixels read per block
+#define TPM2_END_BYTE    0x36
 
 uint16_t currentBaud = 1152; //default baudrate 115200 (divided by 100)
 bool continuousSendLED = false;
 uint32_t lastUpdate = 0;
 
+// buffered TPM2 output, see sendBytes()
+static byte  *serialOutBuf  = nullptr;
+static size_t serialOutSize = 0; // allocated
+static size_t serialOutLen  = 0; // bytes of the frame being sent
+static size_t serialOutPos  = 0; // bytes sent
+
+static void handleSerialOutput() {
+  if (serialOutPos >= serialOutLen) return;
+  int room = Serial.availableForWrite();
+  if (room <= 0) return;
+  size_t n = serialOutLen - serialOutPos;
+  if (n > (size_t)room) n = room;
+  serialOutPos += Serial.write(serialOutBuf + serialOutPos, n);
+}
+
+// sends the rest of a buffered frame (blocking), call before any other serial output so it does not end up
+// inside the binary frame
+void finishSerialOutput() {
+  if (serialOutPos < serialOutLen) Serial.write(serialOutBuf + serialOutPos, serialOutLen - serialOutPos);
+  serialOutLen = serialOutPos = 0;
+}
+
 void updateBaudRate(uint32_t rate){
   uint16_t rate100 = rate/100;
   if (rate100 == currentBaud || rate100 < 96) return;
   currentBaud = rate100;
+  finishSerialOutput(); // complete the pending frame at the old rate
 
   if (!pinManager.isPinAllocated(hardwareTX) || pinManager.getPinOwner(hardwareTX) == PinOwner::DebugOut){
     Serial.print(F("Baud is now ")); Serial.println(rate);
@@ -39,6 +51,7 @@ void updateBaudRate(uint32_t rate){
 // RGB LED data return as JSON array. Slow, but easy to use on the other end.
 void sendJSON(){
   if (!pinManager.isPinAllocated(hardwareTX) || pinManager.getPinOwner(hardwareTX) == PinOwner::DebugOut) {
+    finishSerialOutput();
     uint16_t used = strip.getLengthTotal();
     Serial.write('[');
     for (uint16_t i=0; i<used; i++) {
@@ -50,147 +63,131 @@ void sendJSON(){
 }
 
 // RGB LED data returned as bytes in TPM2 format. Faster, and slightly less easy to use on the other end.
+// The frame is copied into a buffer that handleSerialOutput() hands to the UART as it has room, so sending
+// does not block the loop. A frame requested while the previous one is still being sent is skipped.
 void sendBytes(){
   if (!pinManager.isPinAllocated(hardwareTX) || pinManager.getPinOwner(hardwareTX) == PinOwner::DebugOut) {
-    Serial.write(0xC9); Serial.write(0xDA);
+    if (serialOutPos < serialOutLen) {
+      serialFramesSkipped++;
+      return;
+    }
     uint16_t used = strip.getLengthTotal();
+    if (used > 21845) used = 21845; // TPM2 frame size is 16 bit
     uint16_t len = used*3;
-    Serial.write(highByte(len));
-    Serial.write(lowByte(len));
+    size_t size = len + 6;
+    if (size > serialOutSize) {
+      byte *buf = (byte*)realloc(serialOutBuf, size);
+      if (!buf) return;
+      serialOutBuf  = buf;
+      serialOutSize = size;
+    }
+    byte *p = serialOutBuf;
+    *p++ = 0xC9; *p++ = 0xDA;
+    *p++ = highByte(len);
+    *p++ = lowByte(len);
     for (uint16_t i=0; i < used; i++) {
       uint32_t c = strip.getPixelColor(i);
-      Serial.write(qadd8(W(c), R(c))); //R, add white channel to RGB channels as a simple RGBW -> RGB map
-      Serial.write(qadd8(W(c), G(c))); //G
-      Serial.write(qadd8(W(c), B(c))); //B
+      *p++ = qadd8(W(c), R(c)); //R, add white channel to RGB channels as a simple RGBW -> RGB map
+      *p++ = qadd8(W(c), G(c)); //G
+      *p++ = qadd8(W(c), B(c)); //B
     }
-    Serial.write(0x36); Serial.write('\n');
+    *p++ = TPM2_END_BYTE; *p++ = '\n';
+    serialOutLen = size;
+    serialOutPos = 0;
+    handleSerialOutput();
   }
 }
 
+#ifdef WLED_ENABLE_ADALIGHT
+static void serialPixels(uint16_t index, const uint8_t *rgb, uint16_t count, void *) {
+  if (!realtimeOverride) setRealtimePixels(index, rgb, count);
+}
+
+static void commitSerialFrame(void *) {
+  realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+  if (!realtimeOverride) realtimeShow();
+}
+
+static void replyTPM2Ping(void *) {
+  Serial.write(0xAC);
+}
+
+static SerialPixelParser serialParser(serialPixels, commitSerialFrame, replyTPM2Ping);
+#endif
+
 void handleSerial()
 {
+  handleSerialOutput();
   if (pinManager.isPinAllocated(hardwareRX)) return;
   if (!Serial) return;              // arduino docs: `if (Serial)` indicates whether or not the USB CDC serial connection is open. For all non-USB CDC ports, this will always return true
 
   #ifdef WLED_ENABLE_ADALIGHT
-  static auto state = AdaState::Header_A;
-  static uint16_t count = 0;
-  static uint16_t pixel = 0;
-  static byte check = 0x00;
-  static byte red   = 0x00;
-  static byte green = 0x00;
-
   while (Serial.available() > 0)
   {
     yield();
+    size_t left = serialParser.payloadLeft();
+    if (left) { // frame payload, read in blocks of what is available
+      continuousSendLED = false;
+      byte buf[ADA_CHUNK_PIXELS * 3];
+      size_t n = Serial.available();
+      if (n > left) n = left;
+      if (n > sizeof(buf)) n = sizeof(buf);
+      n = Serial.readBytes(buf, n); // data is available, does not wait
+      serialParser.feed(buf, n);
+      continue;
+    }
+
     byte next = Serial.peek();
-    switch (state) {
-      case AdaState::Header_A:
-        if (next == 'A') state = AdaState::Header_d;
-        else if (next == 0xC9) { //TPM2 start byte
-          state = AdaState::TPM2_Header_Type;
-        }
-        else if (next == 'I') {
-          handleImprovPacket();
-          return;
-        } else if (next == 'v') {
-          Serial.print("WLED"); Serial.write(' '); Serial.println(VERSION);
-
-        } else if (next == 0xB0) {updateBaudRate( 115200);
-        } else if (next == 0xB1) {updateBaudRate( 230400);
-        } else if (next == 0xB2) {updateBaudRate( 460800);
-        } else if (next == 0xB3) {updateBaudRate( 500000);
-        } else if (next == 0xB4) {updateBaudRate( 576000);
-        } else if (next == 0xB5) {updateBaudRate( 921600);
-        } else if (next == 0xB6) {updateBaudRate(1000000);
-        } else if (next == 0xB7) {updateBaudRate(1500000);
-
-        } else if (next == 'l') {sendJSON(); // Send LED data as JSON Array
-        } else if (next == 'L') {sendBytes(); // Send LED data as TPM2 Data Packet
-
-        } else if (next == 'o') {continuousSendLED = false; // Disable Continuous Serial Streaming
-        } else if (next == 'O') {continuousSendLED = true; // Enable Continuous Serial Streaming
-
-        } else if (next == '{') { //JSON API
-          bool verboseResponse = false;
-          if (!requestJSONBufferLock(16)) return;
-          Serial.setTimeout(100);
-          DeserializationError error = deserializeJson(doc, Serial);
-          if (error) {
-            releaseJSONBufferLock();
-            return;
-          }
-          verboseResponse = deserializeState(doc.as<JsonObject>());
-          //only send response if TX pin is unused for other purposes
-          if (verboseResponse && (!pinManager.isPinAllocated(hardwareTX) || pinManager.getPinOwner(hardwareTX) == PinOwner::DebugOut)) {
-            doc.clear();
-            JsonObject state = doc.createNestedObject("state");
-            serializeState(state);
-            JsonObject info  = doc.createNestedObject("info");
-            serializeInfo(info);
-
-            serializeJson(doc, Serial);
-            Serial.println();
-          }
+    if (!serialParser.feed(&next, 1)) { // not part of a frame: command byte
+      if (next == 'I') {
+        finishSerialOutput();
+        handleImprovPacket();
+        return;
+      } else if (next == 'v') {
+        finishSerialOutput();
+        Serial.print("WLED"); Serial.write(' '); Serial.println(VERSION);
+
+      } else if (next == 0xB0) {updateBaudRate( 115200);
+      } else if (next == 0xB1) {updateBaudRate( 230400);
+      } else if (next == 0xB2) {updateBaudRate( 460800);
+      } else if (next == 0xB3) {updateBaudRate( 500000);
+      } else if (next == 0xB4) {updateBaudRate( 576000);
+      } else if (next == 0xB5) {updateBaudRate( 921600);
+      } else if (next == 0xB6) {updateBaudRate(1000000);
+      } else if (next == 0xB7) {updateBaudRate(1500000);
+      } else if (next == 0xB8) {updateBaudRate(2000000);
+      } else if (next == 0xB9) {updateBaudRate(3000000);
+
+      } else if (next == 'l') {sendJSON(); // Send LED data as JSON Array
+      } else if (next == 'L') {sendBytes(); // Send LED data as TPM2 Data Packet
+
+      } else if (next == 'o') {continuousSendLED = false; // Disable Continuous Serial Streaming
+      } else if (next == 'O') {continuousSendLED = true; // Enable Continuous Serial Streaming
+
+      } else if (next == '{') { //JSON API
+        bool verboseResponse = false;
+        if (!requestJSONBufferLock(16)) return;
+        Serial.setTimeout(100);
+        DeserializationError error = deserializeJson(doc, Serial);
+        if (error) {
           releaseJSONBufferLock();
+          return;
         }
-        break;
-      case AdaState::Header_d:
-        if (next == 'd') state = AdaState::Header_a;
-        else             state = AdaState::Header_A;
-        break;
-      case AdaState::Header_a:
-        if (next == 'a') state = AdaState::Header_CountHi;
-        else             state = AdaState::Header_A;
-        break;
-      case AdaState::Header_CountHi:
-        pixel = 0;
-        count = next * 0x100;
-        check = next;
-        state = AdaState::Header_CountLo;
-        break;
-      case AdaState::Header_CountLo:
-        count += next + 1;
-        check = check ^ next ^ 0x55;
-        state = AdaState::Header_CountCheck;
-        break;
-      case AdaState::Header_CountCheck:
-        if (check == next) state = AdaState::Data_Red;
-        else               state = AdaState::Header_A;
-        break;
-      case AdaState::TPM2_Header_Type:
-        state = AdaState::Header_A; //(unsupported) TPM2 command or invalid type
-        if (next == 0xDA) state = AdaState::TPM2_Header_CountHi; //TPM2 data
-        else if (next == 0xAA) Serial.write(0xAC); //TPM2 ping
-        break;
-      case AdaState::TPM2_Header_CountHi:
-        pixel = 0;
-        count = (next * 0x100) /3;
-        state = AdaState::TPM2_Header_CountLo;
-        break;
-      case AdaState::TPM2_Header_CountLo:
-        count += next /3;
-        state = AdaState::Data_Red;
-        break;
-      case AdaState::Data_Red:
-        red   = next;
-        state = AdaState::Data_Green;
-        break;
-      case AdaState::Data_Green:
-        green = next;
-        state = AdaState::Data_Blue;
-        break;
-      case AdaState::Data_Blue:
-        byte blue  = next;
-        if (!realtimeOverride) setRealtimePixel(pixel++, red, green, blue, 0);
-        if (--count > 0) state = AdaState::Data_Red;
-        else {
-          realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
-
-          if (!realtimeOverride) strip.show();
-          state = AdaState::Header_A;
+        verboseResponse = deserializeState(doc.as<JsonObject>());
+        //only send response if TX pin is unused for other purposes
+        if (verboseResponse && (!pinManager.isPinAllocated(hardwareTX) || pinManager.getPinOwner(hardwareTX) == PinOwner::DebugOut)) {
+          doc.clear();
+          JsonObject state = doc.createNestedObject("state");
+          serializeState(state);
+          JsonObject info  = doc.createNestedObject("info");
+          serializeInfo(info);
+
+          finishSerialOutput();
+          serializeJson(doc, Serial);
+          Serial.println();
         }
-        break;
+        releaseJSONBufferLock();
+      }
     }
 
     // All other received bytes will disable Continuous Serial Streaming